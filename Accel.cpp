@@ -0,0 +1,361 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2024 Dad Design.
+//      Accélération des remplissages et des copies de pixels
+//------------------------------------------------------------------------
+#include "Accel.h"
+
+//***********************************************************************************
+// cAccel
+// Exécution par le CPU
+//***********************************************************************************
+
+// --------------------------------------------------------------------------
+// Remplissage
+bool cAccel::Fill(RGB *pDest, uint16_t DestStride, uint16_t Width, uint16_t Height, cColor Color){
+    for(uint16_t PosY = 0; PosY < Height; PosY++){
+        RGB *pPixel = pDest;
+        for(uint16_t Index = 0; Index < Width; Index++){
+            pPixel->R = Color.m_R;
+            pPixel->G = Color.m_G;
+            pPixel->B = Color.m_B;
+            pPixel->A = Color.m_A;
+            pPixel++;
+        }
+        pDest += DestStride;
+    }
+    return true;
+}
+
+// --------------------------------------------------------------------------
+// Copie de pixels
+bool cAccel::Copy(RGB *pDest, uint16_t DestStride, const RGB *pSrc, uint16_t SrcStride,
+                  uint16_t Width, uint16_t Height){
+    for(uint16_t PosY = 0; PosY < Height; PosY++){
+        for(uint16_t Index = 0; Index < Width; Index++){
+            pDest[Index].copy(pSrc[Index]);
+        }
+        pDest += DestStride;
+        pSrc += SrcStride;
+    }
+    return true;
+}
+
+// --------------------------------------------------------------------------
+// Conversion / composition d'une image (même résultat que cGFX::drawImage())
+bool cAccel::Image(RGB *pDest, uint16_t DestStride, const uint8_t *pSrc, uint16_t SrcStride,
+                   TypeImage Type, uint16_t Width, uint16_t Height){
+    cImage Image(SrcStride, Height, Type, pSrc);
+    uint8_t PixelSize = Image.getPixelSize();
+    for(uint16_t PosY = 0; PosY < Height; PosY++){
+        const uint8_t *pImgLine = Image.GetPtrLine(PosY);
+        for(uint16_t Index = 0; Index < Width; Index++){
+            pDest[Index].set(Image.getColor(pImgLine));
+            pImgLine += PixelSize;
+        }
+        pDest += DestStride;
+    }
+    return true;
+}
+
+//***********************************************************************************
+// cAccelDeferred
+// Opération exécutée par le CPU lors de l'attente
+//***********************************************************************************
+
+// --------------------------------------------------------------------------
+// Mémorisation d'un remplissage
+bool cAccelDeferred::Fill(RGB *pDest, uint16_t DestStride, uint16_t Width, uint16_t Height, cColor Color){
+    Push(AccelOp::Fill, pDest, DestStride, nullptr, 0, Width, Height);
+    m_Color = Color;
+    return true;
+}
+
+// --------------------------------------------------------------------------
+// Mémorisation d'une copie
+bool cAccelDeferred::Copy(RGB *pDest, uint16_t DestStride, const RGB *pSrc, uint16_t SrcStride,
+                          uint16_t Width, uint16_t Height){
+    Push(AccelOp::Copy, pDest, DestStride, pSrc, SrcStride, Width, Height);
+    return true;
+}
+
+// --------------------------------------------------------------------------
+// Mémorisation d'une image
+bool cAccelDeferred::Image(RGB *pDest, uint16_t DestStride, const uint8_t *pSrc, uint16_t SrcStride,
+                           TypeImage Type, uint16_t Width, uint16_t Height){
+    Push(AccelOp::Image, pDest, DestStride, pSrc, SrcStride, Width, Height);
+    m_Type = Type;
+    return true;
+}
+
+// --------------------------------------------------------------------------
+// Exécution de l'opération en attente
+void cAccelDeferred::Wait(){
+    if(!m_Pending) return;
+    m_Pending = false;
+    switch(m_Op){
+        case AccelOp::Fill :
+            cAccel::Fill(m_pDest, m_DestStride, m_Width, m_Height, m_Color);
+            break;
+        case AccelOp::Copy :
+            cAccel::Copy(m_pDest, m_DestStride, (const RGB *)m_pSrc, m_SrcStride, m_Width, m_Height);
+            break;
+        case AccelOp::Image :
+            cAccel::Image(m_pDest, m_DestStride, (const uint8_t *)m_pSrc, m_SrcStride, m_Type, m_Width, m_Height);
+            break;
+    }
+}
+
+// --------------------------------------------------------------------------
+// Mémorisation de l'opération, après exécution de la précédente
+void cAccelDeferred::Push(AccelOp Op, RGB *pDest, uint16_t DestStride, const void *pSrc, uint16_t SrcStride,
+                          uint16_t Width, uint16_t Height){
+    Wait();
+    m_Op = Op;
+    m_pDest = pDest;
+    m_DestStride = DestStride;
+    m_pSrc = pSrc;
+    m_SrcStride = SrcStride;
+    m_Width = Width;
+    m_Height = Height;
+    m_Pending = true;
+    m_NbOps++;
+}
+
+#ifdef DMA2D
+//***********************************************************************************
+// cAccelDMA2D
+// Moteur DMA2D des STM32H7
+//   Les pixels RGB (octets R, G, B, A) sont vus par le DMA2D comme des pixels
+//   ARGB8888 dont le rouge et le bleu sont inversés : la même inversion
+//   s'applique à la source et à la destination, aucune conversion n'est
+//   nécessaire sauf pour les images B8G8R8 (RBS de la source).
+//***********************************************************************************
+
+// Modes du DMA2D (CR)
+#define DMA2D_MODE_M2M          0
+#define DMA2D_MODE_M2M_PFC      DMA2D_CR_MODE_0
+#define DMA2D_MODE_M2M_BLEND    DMA2D_CR_MODE_1
+#define DMA2D_MODE_R2M          (DMA2D_CR_MODE_0 | DMA2D_CR_MODE_1)
+
+// Formats des pixels (xPFCCR)
+#define DMA2D_CM_ARGB8888       0
+#define DMA2D_CM_RGB888         1
+
+// Taille d'une ligne du cache de données
+#define DMA2D_CACHE_LINE        32U
+
+// --------------------------------------------------------------------------
+// Nettoyage du cache de données d'une zone (lignes entières)
+static inline void CleanCache(const void *pAddr, uint32_t Size){
+    uint32_t Start = (uint32_t)pAddr & ~(DMA2D_CACHE_LINE - 1);
+    uint32_t End = ((uint32_t)pAddr + Size + DMA2D_CACHE_LINE - 1) & ~(DMA2D_CACHE_LINE - 1);
+    SCB_CleanDCache_by_Addr((uint32_t *)Start, End - Start);
+}
+
+// --------------------------------------------------------------------------
+// Nettoyage puis invalidation du cache de données d'une zone (lignes entières)
+static inline void CleanInvalidateCache(const void *pAddr, uint32_t Size){
+    uint32_t Start = (uint32_t)pAddr & ~(DMA2D_CACHE_LINE - 1);
+    uint32_t End = ((uint32_t)pAddr + Size + DMA2D_CACHE_LINE - 1) & ~(DMA2D_CACHE_LINE - 1);
+    SCB_CleanInvalidateDCache_by_Addr((uint32_t *)Start, End - Start);
+}
+
+// --------------------------------------------------------------------------
+// Invalidation du cache de données d'une zone (lignes entières)
+static inline void InvalidateCache(const void *pAddr, uint32_t Size){
+    uint32_t Start = (uint32_t)pAddr & ~(DMA2D_CACHE_LINE - 1);
+    uint32_t End = ((uint32_t)pAddr + Size + DMA2D_CACHE_LINE - 1) & ~(DMA2D_CACHE_LINE - 1);
+    SCB_InvalidateDCache_by_Addr((uint32_t *)Start, End - Start);
+}
+
+// --------------------------------------------------------------------------
+// Initialisation
+void cAccelDMA2D::Init(){
+    __HAL_RCC_DMA2D_CLK_ENABLE();
+}
+
+// --------------------------------------------------------------------------
+// Remplissage (mode registre vers mémoire)
+bool cAccelDMA2D::Fill(RGB *pDest, uint16_t DestStride, uint16_t Width, uint16_t Height, cColor Color){
+    if(!isReachable(pDest)) return false;
+    Wait();
+    DMA2D->OCOLR = ((uint32_t)Color.m_A << 24) | ((uint32_t)Color.m_B << 16) | ((uint32_t)Color.m_G << 8) | Color.m_R;
+    Start(DMA2D_MODE_R2M, pDest, DestStride, Width, Height);
+    return true;
+}
+
+// --------------------------------------------------------------------------
+// Copie de pixels (mode mémoire vers mémoire)
+bool cAccelDMA2D::Copy(RGB *pDest, uint16_t DestStride, const RGB *pSrc, uint16_t SrcStride,
+                       uint16_t Width, uint16_t Height){
+    if(!isReachable(pDest) || !isReachable(pSrc)) return false;
+    Wait();
+    CleanCache(pSrc, (((uint32_t)(Height - 1) * SrcStride) + Width) * sizeof(RGB));
+    DMA2D->FGMAR = (uint32_t)pSrc;
+    DMA2D->FGOR = SrcStride - Width;
+    DMA2D->FGPFCCR = DMA2D_CM_ARGB8888;
+    Start(DMA2D_MODE_M2M, pDest, DestStride, Width, Height);
+    return true;
+}
+
+// --------------------------------------------------------------------------
+// Conversion d'une image RGB888, ou composition d'une image ARGB8888 par dessus
+// la destination (utilisée comme arrière plan)
+bool cAccelDMA2D::Image(RGB *pDest, uint16_t DestStride, const uint8_t *pSrc, uint16_t SrcStride,
+                        TypeImage Type, uint16_t Width, uint16_t Height){
+    if(!isReachable(pDest) || !isReachable(pSrc)) return false;
+    uint32_t PixelFormat;
+    uint32_t Mode;
+    uint32_t PixelSize;
+    switch(Type){
+        case TypeImage::R8G8B8 :
+            PixelFormat = DMA2D_CM_RGB888;
+            Mode = DMA2D_MODE_M2M_PFC;
+            PixelSize = 3;
+            break;
+        case TypeImage::B8G8R8 :
+            PixelFormat = DMA2D_CM_RGB888 | DMA2D_FGPFCCR_RBS;
+            Mode = DMA2D_MODE_M2M_PFC;
+            PixelSize = 3;
+            break;
+        case TypeImage::R8G8B8A8 :
+            PixelFormat = DMA2D_CM_ARGB8888;
+            Mode = DMA2D_MODE_M2M_BLEND;
+            PixelSize = 4;
+            break;
+        case TypeImage::B8G8R8A8 :
+            PixelFormat = DMA2D_CM_ARGB8888 | DMA2D_FGPFCCR_RBS;
+            Mode = DMA2D_MODE_M2M_BLEND;
+            PixelSize = 4;
+            break;
+        default :
+            return false;
+    }
+    Wait();
+    CleanCache(pSrc, (((uint32_t)(Height - 1) * SrcStride) + Width) * PixelSize);
+    DMA2D->FGMAR = (uint32_t)pSrc;
+    DMA2D->FGOR = SrcStride - Width;
+    DMA2D->FGPFCCR = PixelFormat;
+    if(Mode == DMA2D_MODE_M2M_BLEND){
+        DMA2D->BGMAR = (uint32_t)pDest;
+        DMA2D->BGOR = DestStride - Width;
+        DMA2D->BGPFCCR = DMA2D_CM_ARGB8888;
+    }
+    Start(Mode, pDest, DestStride, Width, Height);
+    return true;
+}
+
+// --------------------------------------------------------------------------
+// Attente de la fin du transfert en cours
+void cAccelDMA2D::Wait(){
+    if(m_pDest == nullptr) return;
+    while((DMA2D->CR & DMA2D_CR_START) != 0){}
+    DMA2D->IFCR = DMA2D_IFCR_CTCIF | DMA2D_IFCR_CTEIF | DMA2D_IFCR_CCEIF;
+    InvalidateCache(m_pDest, m_DestSize);
+    m_pDest = nullptr;
+}
+
+// --------------------------------------------------------------------------
+// Test si un transfert est en cours
+bool cAccelDMA2D::isBusy(){
+    return (DMA2D->CR & DMA2D_CR_START) != 0;
+}
+
+// --------------------------------------------------------------------------
+// Configuration de la destination, puis lancement du transfert
+void cAccelDMA2D::Start(uint32_t Mode, RGB *pDest, uint16_t DestStride, uint16_t Width, uint16_t Height){
+    m_pDest = pDest;
+    m_DestSize = (((uint32_t)(Height - 1) * DestStride) + Width) * sizeof(RGB);
+    CleanInvalidateCache(pDest, m_DestSize);
+
+    DMA2D->CR = Mode;
+    DMA2D->OPFCCR = DMA2D_CM_ARGB8888;
+    DMA2D->OMAR = (uint32_t)pDest;
+    DMA2D->OOR = DestStride - Width;
+    DMA2D->NLR = ((uint32_t)Width << DMA2D_NLR_PL_Pos) | Height;
+    DMA2D->IFCR = DMA2D_IFCR_CTCIF | DMA2D_IFCR_CTEIF | DMA2D_IFCR_CCEIF;
+    DMA2D->CR |= DMA2D_CR_START;
+}
+
+// --------------------------------------------------------------------------
+// Test si une adresse est accessible par le DMA2D
+// ITCM : 0x00000000 - 0x0000FFFF, DTCM : 0x20000000 - 0x2001FFFF
+bool cAccelDMA2D::isReachable(const void *pAddr){
+    uint32_t Addr = (uint32_t)pAddr;
+    return (Addr >= 0x00010000) && ((Addr < 0x20000000) || (Addr >= 0x20020000));
+}
+#endif
+
+//***********************************************************************************
+// cRBG_Frame : accélérateur
+//***********************************************************************************
+
+// --------------------------------------------------------------------------
+// Sélection de l'accélérateur
+void cRBG_Frame::setAccel(cAccel *pAccel){
+    waitAccel();
+    m_pAccel = pAccel;
+}
+
+// --------------------------------------------------------------------------
+// Attente de la fin de l'opération confiée à l'accélérateur
+void cRBG_Frame::waitAccel(){
+    if(m_pAccel != nullptr){
+        m_pAccel->Wait();
+    }
+    m_AccelBusy = false;
+}
+
+//***********************************************************************************
+// cGFX : opérations confiées à l'accélérateur
+//   Chaque fonction retourne false si l'opération doit être réalisée par le CPU.
+//   L'adresse de la zone est lue par getPtr() : l'opération précédente est
+//   terminée avant le lancement de la suivante.
+//***********************************************************************************
+
+// --------------------------------------------------------------------------
+// Test si une zone de la destination peut être confiée à l'accélérateur
+bool cGFX::isAccelArea(const sRect &Rect){
+    return (m_pAccel != nullptr) &&
+           (((uint32_t)(Rect.m_x1 - Rect.m_x0) * (Rect.m_y1 - Rect.m_y0)) >= ACCEL_MIN_PIXELS) &&
+           isRowsContiguous(Rect.m_y0, Rect.m_y1);
+}
+
+// --------------------------------------------------------------------------
+// Remplissage d'une zone de la destination (sans composition)
+bool cGFX::accelFill(const sRect &Rect, cColor Color){
+    if(!isAccelArea(Rect)) return false;
+    RGB *pDest = getPtr(Rect.m_x0, Rect.m_y0);
+    if(!m_pAccel->Fill(pDest, getStride(), Rect.m_x1 - Rect.m_x0, Rect.m_y1 - Rect.m_y0, Color)) return false;
+    m_AccelBusy = true;
+    return true;
+}
+
+// --------------------------------------------------------------------------
+// Copie de pixels entre la destination et une autre mémoire
+bool cGFX::accelCopy(RGB *pDest, uint16_t DestStride, const RGB *pSrc, uint16_t SrcStride,
+                     uint16_t Width, uint16_t Height){
+    if(!m_pAccel->Copy(pDest, DestStride, pSrc, SrcStride, Width, Height)) return false;
+    m_AccelBusy = true;
+    return true;
+}
+
+// --------------------------------------------------------------------------
+// Dessin de la partie Rect d'une image placée en (x, y)
+// Les images avec transparence ne sont confiées à l'accélérateur que si tous les
+// pixels de la destination sont opaques : seule la frame le garantit (ClearFrame,
+// set() et eraseRect() y laissent A = 255). Sur un pixel transparent le DMA2D
+// écrirait la couleur de l'image sans la mélanger au noir.
+bool cGFX::accelImage(const sRect &Rect, cImage &Image, int16_t x, int16_t y){
+    if(!isAccelArea(Rect)) return false;
+    TypeImage Type = Image.getType();
+    bool Alpha = (Type == TypeImage::R8G8B8A8) || (Type == TypeImage::B8G8R8A8);
+    if(Alpha && (m_pFrame != m_pFrameBuff)) return false;
+
+    RGB *pDest = getPtr(Rect.m_x0, Rect.m_y0);
+    const uint8_t *pSrc = Image.GetPtrLine(Rect.m_y0 - y) + ((Rect.m_x0 - x) * Image.getPixelSize());
+    if(!m_pAccel->Image(pDest, getStride(), pSrc, Image.getWith(), Type,
+                        Rect.m_x1 - Rect.m_x0, Rect.m_y1 - Rect.m_y0)) return false;
+    m_AccelBusy = true;
+    return true;
+}
@@ -0,0 +1,140 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2024 Dad Design.
+//      Accélération des remplissages et des copies de pixels
+//
+//      cGFX confie les grandes zones (remplissages, copies, images) à un
+//      accélérateur (voir cGFX::setAccel()). Une opération peut se terminer en
+//      arrière-plan : la frame attend sa fin avant tout autre accès aux pixels
+//      (primitive, FlushFrame(), opération suivante).
+//
+//      cAccel        : exécution par le CPU (référence et repli)
+//      cAccelDeferred: opération mémorisée et exécutée à l'attente (tests hors cible)
+//      cAccelDMA2D   : moteur DMA2D des STM32H7
+//------------------------------------------------------------------------
+#pragma once
+#include "GFX.h"
+
+// Nombre min de pixels d'une zone confiée à l'accélérateur
+// Peut être redéfinie dans UserConfig.h
+#ifndef ACCEL_MIN_PIXELS
+    #define ACCEL_MIN_PIXELS 512
+#endif
+
+//***********************************************************************************
+// cAccel
+//  Les zones sont décrites par l'adresse de leur premier pixel et l'écart en
+//  pixels entre deux lignes (Stride). Chaque opération retourne false si elle ne
+//  peut pas être prise en charge : cGFX réalise alors l'opération par le CPU.
+//  L'implémentation de base exécute les opérations immédiatement par le CPU.
+//***********************************************************************************
+class cAccel {
+public:
+    virtual ~cAccel() {}
+
+    // --------------------------------------------------------------------------
+    // Remplissage : les pixels prennent la valeur Color (sans composition)
+    virtual bool Fill(RGB *pDest, uint16_t DestStride, uint16_t Width, uint16_t Height, cColor Color);
+
+    // --------------------------------------------------------------------------
+    // Copie de pixels, les zones ne doivent pas se recouvrir
+    virtual bool Copy(RGB *pDest, uint16_t DestStride, const RGB *pSrc, uint16_t SrcStride,
+                      uint16_t Width, uint16_t Height);
+
+    // --------------------------------------------------------------------------
+    // Conversion d'une image R8G8B8 / B8G8R8 (pixels opaques)
+    // Images R8G8B8A8 / B8G8R8A8 : composition par dessus la destination, dont tous
+    // les pixels doivent être opaques (A = 255). cGFX ne les confie à
+    // l'accélérateur que pour la frame, toujours opaque.
+    //   pSrc : premier pixel, SrcStride : écart en pixels entre deux lignes
+    virtual bool Image(RGB *pDest, uint16_t DestStride, const uint8_t *pSrc, uint16_t SrcStride,
+                       TypeImage Type, uint16_t Width, uint16_t Height);
+
+    // --------------------------------------------------------------------------
+    // Attente de la fin de l'opération en cours
+    virtual void Wait() {}
+
+    // --------------------------------------------------------------------------
+    // Test si une opération est en cours
+    virtual bool isBusy() { return false; }
+};
+
+//***********************************************************************************
+// cAccelDeferred
+//  Comme le DMA2D, une seule opération à la fois, mais exécutée par le CPU lors
+//  de Wait() : tant que la frame n'a pas attendu, les pixels ne sont pas
+//  modifiés, ce qui met en évidence un accès sans attente.
+//***********************************************************************************
+class cAccelDeferred : public cAccel {
+public:
+    bool Fill(RGB *pDest, uint16_t DestStride, uint16_t Width, uint16_t Height, cColor Color) override;
+    bool Copy(RGB *pDest, uint16_t DestStride, const RGB *pSrc, uint16_t SrcStride,
+              uint16_t Width, uint16_t Height) override;
+    bool Image(RGB *pDest, uint16_t DestStride, const uint8_t *pSrc, uint16_t SrcStride,
+               TypeImage Type, uint16_t Width, uint16_t Height) override;
+    void Wait() override;
+    inline bool isBusy() override { return m_Pending; }
+
+    // --------------------------------------------------------------------------
+    // Nombre d'opérations reçues depuis l'initialisation
+    inline uint32_t getNbOps() { return m_NbOps; }
+
+protected:
+    enum class AccelOp : uint8_t {
+        Fill,
+        Copy,
+        Image
+    };
+
+    // Mémorisation de l'opération, après exécution de la précédente
+    void Push(AccelOp Op, RGB *pDest, uint16_t DestStride, const void *pSrc, uint16_t SrcStride,
+              uint16_t Width, uint16_t Height);
+
+    // Opération en attente
+    bool        m_Pending = false;
+    AccelOp     m_Op = AccelOp::Fill;
+    RGB        *m_pDest = nullptr;
+    uint16_t    m_DestStride = 0;
+    const void *m_pSrc = nullptr;
+    uint16_t    m_SrcStride = 0;
+    uint16_t    m_Width = 0;
+    uint16_t    m_Height = 0;
+    TypeImage   m_Type = TypeImage::R8G8B8;
+    cColor      m_Color = cColor(0, 0, 0);
+    uint32_t    m_NbOps = 0;
+};
+
+#ifdef DMA2D
+//***********************************************************************************
+// cAccelDMA2D
+//  Une opération à la fois, lancée sans attendre sa fin. Les zones sont
+//  nettoyées du cache de données avant le transfert et la destination est
+//  invalidée à la fin : les mémoires utilisées (frame, calques, canevas,
+//  sauvegardes) doivent être alignées sur 32 octets.
+//  Le DMA2D n'accède pas aux mémoires DTCM / ITCM : les zones qui y sont placées
+//  sont traitées par le CPU.
+//***********************************************************************************
+class cAccelDMA2D : public cAccel {
+public:
+    // --------------------------------------------------------------------------
+    // Initialisation : activation de l'horloge du DMA2D
+    void Init();
+
+    bool Fill(RGB *pDest, uint16_t DestStride, uint16_t Width, uint16_t Height, cColor Color) override;
+    bool Copy(RGB *pDest, uint16_t DestStride, const RGB *pSrc, uint16_t SrcStride,
+              uint16_t Width, uint16_t Height) override;
+    bool Image(RGB *pDest, uint16_t DestStride, const uint8_t *pSrc, uint16_t SrcStride,
+               TypeImage Type, uint16_t Width, uint16_t Height) override;
+    void Wait() override;
+    bool isBusy() override;
+
+protected:
+    // Configuration de la destination, puis lancement du transfert
+    void Start(uint32_t Mode, RGB *pDest, uint16_t DestStride, uint16_t Width, uint16_t Height);
+
+    // Test si une zone est accessible par le DMA2D
+    static bool isReachable(const void *pAddr);
+
+    RGB        *m_pDest = nullptr;          // Destination du transfert en cours
+    uint32_t    m_DestSize = 0;             // Taille en octets de la destination
+};
+#endif
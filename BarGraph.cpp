@@ -0,0 +1,163 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2024 Dad Design.
+//      Bargraphe : affichage d'un ensemble de barres verticales (analyseur de spectre)
+//------------------------------------------------------------------------
+#include "BarGraph.h"
+
+//***********************************************************************************
+// cBarGraph
+//***********************************************************************************
+
+// --------------------------------------------------------------------------
+// Initialisation et dessin du fond
+void cBarGraph::Init(cGFX *pGFX, int16_t x, int16_t y, uint16_t Width, uint16_t Height,
+                     uint8_t NbBars, uint8_t Gap, cColor BottomColor, cColor TopColor, cColor BackColor){
+    if(NbBars > BARGRAPH_MAX_BARS) NbBars = BARGRAPH_MAX_BARS;
+    if(NbBars < 1) NbBars = 1;
+    if(Height < 1) Height = 1;
+
+    m_pGFX = pGFX;
+    m_x = x;
+    m_y = y;
+    m_Width = Width;
+    m_Height = Height;
+    m_NbBars = NbBars;
+    m_Gap = Gap;
+    m_BarWidth = (Width > (Gap * (NbBars - 1))) ? (Width - (Gap * (NbBars - 1))) / NbBars : 1;
+    if(m_BarWidth < 1) m_BarWidth = 1;
+    m_BackColor = BackColor;
+
+    // Dégradé : couleur de la ligne 0 et incrément par ligne en 16.16
+    m_BottomColor = BottomColor;
+    m_Gradient = (BottomColor.m_R != TopColor.m_R) || (BottomColor.m_G != TopColor.m_G) ||
+                 (BottomColor.m_B != TopColor.m_B);
+    int32_t Rows = (Height > 1) ? Height - 1 : 1;
+    m_R0 = BottomColor.m_R << 16;
+    m_G0 = BottomColor.m_G << 16;
+    m_B0 = BottomColor.m_B << 16;
+    m_dR = (((int32_t)TopColor.m_R - BottomColor.m_R) * 65536) / Rows;
+    m_dG = (((int32_t)TopColor.m_G - BottomColor.m_G) * 65536) / Rows;
+    m_dB = (((int32_t)TopColor.m_B - BottomColor.m_B) * 65536) / Rows;
+
+    for(uint8_t Index = 0; Index < BARGRAPH_MAX_BARS; Index++){
+        m_Target[Index] = 0;
+    }
+    Redraw();
+}
+
+// --------------------------------------------------------------------------
+// Configuration du marqueur de crête
+void cBarGraph::setPeakHold(bool Enable, uint16_t HoldFrames, uint16_t DecayRows, cColor PeakColor){
+    m_PeakEnable = Enable;
+    m_HoldFrames = HoldFrames;
+    m_DecayRows = (DecayRows < 1) ? 1 : DecayRows;
+    m_PeakColor = PeakColor;
+    Redraw();
+}
+
+// --------------------------------------------------------------------------
+// Valeurs de toutes les barres
+void cBarGraph::setValues(const float *pValues){
+    for(uint8_t Index = 0; Index < m_NbBars; Index++){
+        setValue(Index, pValues[Index]);
+    }
+}
+
+// --------------------------------------------------------------------------
+// Redessine entièrement le bargraphe
+// Sans effet avant Init() : la configuration est dessinée par Init()
+void cBarGraph::Redraw(){
+    if(m_pGFX == nullptr) return;
+    m_pGFX->drawFillRect(m_x, m_y, m_Width, m_Height, m_BackColor);
+    for(uint8_t Index = 0; Index < m_NbBars; Index++){
+        m_Bar[Index] = 0;
+        m_Peak[Index] = 0;
+        m_Hold[Index] = 0;
+        fillRows(Index, 0, 1);
+    }
+    Update();
+}
+
+// --------------------------------------------------------------------------
+// Mise à jour des barres
+// Pour chaque barre seules les lignes entre l'ancienne et la nouvelle hauteur
+// sont écrites, ainsi que l'ancienne et la nouvelle ligne du marqueur de crête.
+void cBarGraph::Update(){
+    for(uint8_t Index = 0; Index < m_NbBars; Index++){
+        uint16_t OldBar = m_Bar[Index];
+        uint16_t OldPeak = m_Peak[Index];
+        uint16_t Bar = m_Target[Index];
+
+        // Crête : maintien puis descente, jamais sous le sommet de la barre
+        uint16_t Peak = OldPeak;
+        if(Bar >= Peak){
+            Peak = Bar;
+            m_Hold[Index] = m_HoldFrames;
+        }else if(m_Hold[Index] > 0){
+            m_Hold[Index]--;
+        }else{
+            Peak = (Peak > Bar + m_DecayRows) ? Peak - m_DecayRows : Bar;
+        }
+
+        if((Bar == OldBar) && (Peak == OldPeak)) continue;
+        m_Bar[Index] = Bar;
+        m_Peak[Index] = Peak;
+
+        // Lignes entre l'ancienne et la nouvelle hauteur
+        int16_t r0 = (Bar < OldBar) ? Bar : OldBar;
+        int16_t r1 = (Bar < OldBar) ? OldBar : Bar;
+        fillRows(Index, r0, r1);
+
+        // Ancienne et nouvelle ligne du marqueur (si hors de la plage déjà écrite)
+        if(m_PeakEnable && (Peak != OldPeak)){
+            if((OldPeak < r0) || (OldPeak >= r1)) fillRows(Index, OldPeak, OldPeak + 1);
+            if((Peak < r0) || (Peak >= r1)) fillRows(Index, Peak, Peak + 1);
+        }
+    }
+}
+
+// --------------------------------------------------------------------------
+// Remplissage des lignes [r0, r1[ d'une barre selon son état courant
+void cBarGraph::fillRows(uint8_t Index, int16_t r0, int16_t r1){
+    if(r1 > (int16_t)m_Height) r1 = m_Height;
+    if(r0 >= r1) return;
+    int16_t Bar = m_Bar[Index];
+    int16_t x = getBarX(Index);
+
+    // Partie barre
+    int16_t End = (r1 < Bar) ? r1 : Bar;
+    if(r0 < End){
+        if(!m_Gradient){
+            m_pGFX->drawFillRect(x, getRowY(End - 1), m_BarWidth, End - r0, m_BottomColor);
+        }else{
+            int32_t R = m_R0 + (m_dR * r0);
+            int32_t G = m_G0 + (m_dG * r0);
+            int32_t B = m_B0 + (m_dB * r0);
+            for(int16_t Row = r0; Row < End; Row++){
+                m_pGFX->drawFillRect(x, getRowY(Row), m_BarWidth, 1, cColor(R >> 16, G >> 16, B >> 16));
+                R += m_dR;
+                G += m_dG;
+                B += m_dB;
+            }
+        }
+    }
+
+    // Partie fond
+    fillBackRows(Index, (r0 > Bar) ? r0 : Bar, r1);
+}
+
+// --------------------------------------------------------------------------
+// Remplissage des lignes [r0, r1[ avec la couleur de fond et le marqueur de crête
+void cBarGraph::fillBackRows(uint8_t Index, int16_t r0, int16_t r1){
+    if(r0 >= r1) return;
+    int16_t x = getBarX(Index);
+    int16_t Peak = m_Peak[Index];
+
+    if(m_PeakEnable && (Peak >= r0) && (Peak < r1)){
+        if(r0 < Peak) m_pGFX->drawFillRect(x, getRowY(Peak - 1), m_BarWidth, Peak - r0, m_BackColor);
+        m_pGFX->drawFillRect(x, getRowY(Peak), m_BarWidth, 1, m_PeakColor);
+        if((Peak + 1) < r1) m_pGFX->drawFillRect(x, getRowY(r1 - 1), m_BarWidth, r1 - Peak - 1, m_BackColor);
+    }else{
+        m_pGFX->drawFillRect(x, getRowY(r1 - 1), m_BarWidth, r1 - r0, m_BackColor);
+    }
+}
@@ -0,0 +1,106 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2024 Dad Design.
+//      Bargraphe : affichage d'un ensemble de barres verticales (analyseur de spectre)
+//
+//      Chaque barre mémorise sa hauteur et son marqueur de crête. A chaque mise
+//      à jour seules les lignes qui changent sont écrites dans la frame.
+//------------------------------------------------------------------------
+#pragma once
+#include "GFX.h"
+
+// Nombre max de barres d'un bargraphe
+// Peut être redéfinie dans UserConfig.h
+#ifndef BARGRAPH_MAX_BARS
+    #define BARGRAPH_MAX_BARS 64
+#endif
+
+//***********************************************************************************
+// cBarGraph
+// Les hauteurs sont exprimées en lignes à partir du bas du bargraphe.
+// Une barre de hauteur h occupe les lignes [0, h[, le marqueur de crête est placé
+// sur la ligne Peak >= h (juste au dessus de la barre lorsque Peak = h).
+//
+// Les couleurs des barres suivent un dégradé vertical de BottomColor à TopColor,
+// calculé de façon incrémentale ligne après ligne (couleur unie si les deux
+// couleurs sont identiques).
+//***********************************************************************************
+class cBarGraph {
+public:
+    // --------------------------------------------------------------------------
+    // Initialisation et dessin du fond
+    //   Gap : espace en pixels entre deux barres
+    void Init(cGFX *pGFX, int16_t x, int16_t y, uint16_t Width, uint16_t Height,
+              uint8_t NbBars, uint8_t Gap, cColor BottomColor, cColor TopColor, cColor BackColor);
+
+    // --------------------------------------------------------------------------
+    // Configuration du marqueur de crête
+    //   HoldFrames : nombre de mises à jour pendant lesquelles la crête est maintenue
+    //   DecayRows  : nombre de lignes de descente par mise à jour ensuite
+    //   Peut être appelée avant Init()
+    void setPeakHold(bool Enable, uint16_t HoldFrames, uint16_t DecayRows, cColor PeakColor);
+
+    // --------------------------------------------------------------------------
+    // Valeur d'une barre dans [0, 1], appliquée au prochain Update()
+    inline void setValue(uint8_t Index, float Value){
+        if(Index >= m_NbBars) return;
+        if(Value < 0.0f) Value = 0.0f;
+        if(Value > 1.0f) Value = 1.0f;
+        m_Target[Index] = (uint16_t)((Value * m_Height) + 0.5f);
+    }
+
+    // Valeurs de toutes les barres
+    void setValues(const float *pValues);
+
+    // --------------------------------------------------------------------------
+    // Mise à jour des barres : seules les lignes modifiées sont écrites
+    void Update();
+
+    // Redessine entièrement le bargraphe
+    void Redraw();
+
+protected:
+    // Remplissage des lignes [r0, r1[ d'une barre selon son état courant
+    void fillRows(uint8_t Index, int16_t r0, int16_t r1);
+
+    // Remplissage des lignes [r0, r1[ de la barre avec la couleur de fond
+    // Le marqueur de crête est intercalé s'il se trouve dans cette plage
+    void fillBackRows(uint8_t Index, int16_t r0, int16_t r1);
+
+    // Abscisse d'une barre
+    inline int16_t getBarX(uint8_t Index){
+        return m_x + (Index * (m_BarWidth + m_Gap));
+    }
+
+    // Ordonnée écran d'une ligne de barre
+    inline int16_t getRowY(int16_t Row){
+        return m_y + m_Height - 1 - Row;
+    }
+
+    // Etat des barres
+    uint16_t    m_Target[BARGRAPH_MAX_BARS];    // Hauteur demandée
+    uint16_t    m_Bar[BARGRAPH_MAX_BARS];       // Hauteur affichée
+    uint16_t    m_Peak[BARGRAPH_MAX_BARS];      // Ligne du marqueur de crête
+    uint16_t    m_Hold[BARGRAPH_MAX_BARS];      // Compteur de maintien de la crête
+
+    cGFX       *m_pGFX = nullptr;
+    int16_t     m_x = 0;
+    int16_t     m_y = 0;
+    uint16_t    m_Width = 0;
+    uint16_t    m_Height = 0;
+    uint8_t     m_NbBars = 0;
+    uint8_t     m_Gap = 0;
+    uint16_t    m_BarWidth = 0;
+
+    // Dégradé en virgule fixe 16.16 : couleur de la ligne 0 et pas par ligne
+    bool        m_Gradient = false;
+    int32_t     m_R0 = 0, m_G0 = 0, m_B0 = 0;
+    int32_t     m_dR = 0, m_dG = 0, m_dB = 0;
+    cColor      m_BottomColor = cColor(0, 255, 0);
+    cColor      m_BackColor = cColor(0, 0, 0);
+
+    // Crête
+    bool        m_PeakEnable = false;
+    uint16_t    m_HoldFrames = 0;
+    uint16_t    m_DecayRows = 1;
+    cColor      m_PeakColor = cColor(255, 255, 255);
+};
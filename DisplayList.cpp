@@ -0,0 +1,352 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2024 Dad Design.
+//      Liste d'affichage (mode retenu)
+//------------------------------------------------------------------------
+#include "DisplayList.h"
+
+//***********************************************************************************
+// cDisplayList
+//***********************************************************************************
+
+// --------------------------------------------------------------------------
+// Initialisation
+void cDisplayList::Init(cGFX *pGFX, cColor BackColor){
+    m_pGFX = pGFX;
+    m_BackColor = BackColor;
+    updateSize();
+    Clear();
+}
+
+// --------------------------------------------------------------------------
+// Taille des blocs d'après la taille courante de l'écran
+// Après un changement d'orientation (quart de tour) toute la surface est invalidée
+void cDisplayList::updateSize(){
+    uint16_t BlocWidth = m_pGFX->getWidth() / FRAME_GRILLE;
+    uint16_t BlocHeight = m_pGFX->getHeight() / FRAME_GRILLE;
+    if((BlocWidth == m_BlocWidth) && (BlocHeight == m_BlocHeight)) return;
+    m_BlocWidth = BlocWidth;
+    m_BlocHeight = BlocHeight;
+    m_Dirty.setAll();
+}
+
+// --------------------------------------------------------------------------
+// Suppression de toutes les commandes
+void cDisplayList::Clear(){
+    m_NbCommands = 0;
+    m_Dirty.setAll();
+}
+
+// ==========================================================================
+// Enregistrement des commandes
+
+// --------------------------------------------------------------------------
+// Enregistrement d'une commande : paramètres, boite englobante et invalidation
+// Retourne -1 si la liste est pleine
+DLHandle cDisplayList::addCommand(DLCommand Type, cColor Color, const int16_t *pParam, uint8_t NbParam,
+                                  const void *pData, cFont *pFont){
+    if(m_NbCommands >= DISPLAY_LIST_SIZE) return -1;
+    sDLCommand &Command = m_Commands[m_NbCommands];
+    Command.m_Type = Type;
+    Command.m_Visible = true;
+    Command.m_Color = Color;
+    for(uint8_t Index = 0; Index < NbParam; Index++){
+        Command.m_Param[Index] = pParam[Index];
+    }
+    Command.m_pData = pData;
+    Command.m_pFont = pFont;
+    setBox(Command);
+    return m_NbCommands++;
+}
+
+DLHandle cDisplayList::addFillRect(int16_t x, int16_t y, int16_t dx, int16_t dy, cColor Color){
+    const int16_t Param[] = {x, y, dx, dy};
+    return addCommand(DLCommand::FillRect, Color, Param, 4);
+}
+
+DLHandle cDisplayList::addRect(int16_t x, int16_t y, int16_t dx, int16_t dy, cColor Color){
+    const int16_t Param[] = {x, y, dx, dy};
+    return addCommand(DLCommand::Rect, Color, Param, 4);
+}
+
+DLHandle cDisplayList::addLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, cColor Color){
+    const int16_t Param[] = {x0, y0, x1, y1};
+    return addCommand(DLCommand::Line, Color, Param, 4);
+}
+
+DLHandle cDisplayList::addCircle(int16_t centerX, int16_t centerY, uint16_t radius, cColor Color){
+    const int16_t Param[] = {centerX, centerY, (int16_t)radius};
+    return addCommand(DLCommand::Circle, Color, Param, 3);
+}
+
+DLHandle cDisplayList::addArc(int16_t centerX, int16_t centerY, uint16_t radius, uint16_t AlphaIn, uint16_t AlphaOut, cColor Color){
+    const int16_t Param[] = {centerX, centerY, (int16_t)radius, (int16_t)AlphaIn, (int16_t)AlphaOut};
+    return addCommand(DLCommand::Arc, Color, Param, 5);
+}
+
+DLHandle cDisplayList::addFillCircle(int16_t centerX, int16_t centerY, uint16_t radius, cColor Color){
+    const int16_t Param[] = {centerX, centerY, (int16_t)radius};
+    return addCommand(DLCommand::FillCircle, Color, Param, 3);
+}
+
+DLHandle cDisplayList::addFillEllipse(int16_t centerX, int16_t centerY, uint16_t radiusX, uint16_t radiusY, cColor Color){
+    const int16_t Param[] = {centerX, centerY, (int16_t)radiusX, (int16_t)radiusY};
+    return addCommand(DLCommand::FillEllipse, Color, Param, 4);
+}
+
+DLHandle cDisplayList::addFillRoundRect(int16_t x, int16_t y, int16_t dx, int16_t dy, uint16_t radius, cColor Color){
+    const int16_t Param[] = {x, y, dx, dy, (int16_t)radius};
+    return addCommand(DLCommand::FillRoundRect, Color, Param, 5);
+}
+
+DLHandle cDisplayList::addFillArc(int16_t centerX, int16_t centerY, uint16_t innerRadius, uint16_t outerRadius,
+                                  uint16_t AlphaIn, uint16_t AlphaOut, cColor Color){
+    const int16_t Param[] = {centerX, centerY, (int16_t)innerRadius, (int16_t)outerRadius,
+                             (int16_t)AlphaIn, (int16_t)AlphaOut};
+    return addCommand(DLCommand::FillArc, Color, Param, 6);
+}
+
+DLHandle cDisplayList::addAALine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, cColor Color){
+    const int16_t Param[] = {x0, y0, x1, y1};
+    return addCommand(DLCommand::AALine, Color, Param, 4);
+}
+
+DLHandle cDisplayList::addAACircle(int16_t centerX, int16_t centerY, uint16_t radius, cColor Color){
+    const int16_t Param[] = {centerX, centerY, (int16_t)radius};
+    return addCommand(DLCommand::AACircle, Color, Param, 3);
+}
+
+DLHandle cDisplayList::addImage(int16_t x, int16_t y, cImage *pImage){
+    const int16_t Param[] = {x, y};
+    return addCommand(DLCommand::Image, cColor(0, 0, 0), Param, 2, pImage);
+}
+
+DLHandle cDisplayList::addText(int16_t x, int16_t y, const char *Text, cFont *pFont, cColor Color){
+    const int16_t Param[] = {x, y};
+    return addCommand(DLCommand::Text, Color, Param, 2, Text, pFont);
+}
+
+// --------------------------------------------------------------------------
+// Calcul de la boite englobante d'une commande et invalidation de la zone couverte
+void cDisplayList::setBox(sDLCommand &Command){
+    int16_t *p = Command.m_Param;
+    sRect &Box = Command.m_Box;
+    switch(Command.m_Type){
+        case DLCommand::FillRect :
+        case DLCommand::FillRoundRect :
+        case DLCommand::Rect : {
+            int16_t x = p[0], y = p[1], dx = p[2], dy = p[3];
+            if(dx < 0){ x += dx; dx = -dx;}
+            if(dy < 0){ y += dy; dy = -dy;}
+            // drawRect trace le contour de (x, y) à (x + dx, y + dy) inclus
+            int16_t Extra = (Command.m_Type == DLCommand::Rect) ? 1 : 0;
+            Box = {x, y, (int16_t)(x + dx + Extra), (int16_t)(y + dy + Extra)};
+            break;
+        }
+        case DLCommand::Line :
+        case DLCommand::AALine : {
+            // Marge d'un pixel pour les lignes anti-aliasées
+            int16_t Margin = (Command.m_Type == DLCommand::AALine) ? 1 : 0;
+            Box.m_x0 = ((p[0] < p[2]) ? p[0] : p[2]) - Margin;
+            Box.m_y0 = ((p[1] < p[3]) ? p[1] : p[3]) - Margin;
+            Box.m_x1 = ((p[0] > p[2]) ? p[0] : p[2]) + 1 + Margin;
+            Box.m_y1 = ((p[1] > p[3]) ? p[1] : p[3]) + 1 + Margin;
+            break;
+        }
+        case DLCommand::Circle :
+        case DLCommand::Arc :
+        case DLCommand::FillCircle :
+        case DLCommand::AACircle : {
+            int16_t r = p[2] + ((Command.m_Type == DLCommand::AACircle) ? 1 : 0);
+            Box = {(int16_t)(p[0] - r), (int16_t)(p[1] - r), (int16_t)(p[0] + r + 1), (int16_t)(p[1] + r + 1)};
+            break;
+        }
+        case DLCommand::FillArc : {
+            int16_t r = (p[3] > p[2]) ? p[3] : p[2];
+            Box = {(int16_t)(p[0] - r), (int16_t)(p[1] - r), (int16_t)(p[0] + r + 1), (int16_t)(p[1] + r + 1)};
+            break;
+        }
+        case DLCommand::FillEllipse :
+            Box = {(int16_t)(p[0] - p[2]), (int16_t)(p[1] - p[3]), (int16_t)(p[0] + p[2] + 1), (int16_t)(p[1] + p[3] + 1)};
+            break;
+        case DLCommand::Image : {
+            cImage *pImage = (cImage *)Command.m_pData;
+            Box = {p[0], p[1], (int16_t)(p[0] + pImage->getWith()), (int16_t)(p[1] + pImage->getHeight())};
+            break;
+        }
+        case DLCommand::Text : {
+            cFont *pFont = Command.m_pFont;
+            int16_t y = p[1] - pFont->getPosHeight();
+            Box = {p[0], y, (int16_t)(p[0] + pFont->getTextWidth((const char *)Command.m_pData)),
+                   (int16_t)(y + pFont->getHeight())};
+            break;
+        }
+    }
+    if(Command.m_Visible){
+        Invalidate(Box);
+    }
+}
+
+// ==========================================================================
+// Modification des commandes
+
+// --------------------------------------------------------------------------
+// Changement de couleur
+void cDisplayList::setColor(DLHandle Handle, cColor Color){
+    if(!isValid(Handle)) return;
+    sDLCommand &Command = m_Commands[Handle];
+    Command.m_Color = Color;
+    if(Command.m_Visible) Invalidate(Command.m_Box);
+}
+
+// --------------------------------------------------------------------------
+// Affichage / masquage
+void cDisplayList::setVisible(DLHandle Handle, bool Visible){
+    if(!isValid(Handle)) return;
+    sDLCommand &Command = m_Commands[Handle];
+    if(Command.m_Visible == Visible) return;
+    Command.m_Visible = Visible;
+    Invalidate(Command.m_Box);
+}
+
+// --------------------------------------------------------------------------
+// Déplacement relatif : l'ancienne et la nouvelle position sont invalidées
+void cDisplayList::Move(DLHandle Handle, int16_t dx, int16_t dy){
+    if(!isValid(Handle)) return;
+    sDLCommand &Command = m_Commands[Handle];
+    if(Command.m_Visible) Invalidate(Command.m_Box);
+    Command.m_Param[0] += dx;
+    Command.m_Param[1] += dy;
+    // Les lignes ont deux extrémités
+    if((Command.m_Type == DLCommand::Line) || (Command.m_Type == DLCommand::AALine)){
+        Command.m_Param[2] += dx;
+        Command.m_Param[3] += dy;
+    }
+    setBox(Command);
+}
+
+// --------------------------------------------------------------------------
+// Changement du texte d'une commande Text
+void cDisplayList::setText(DLHandle Handle, const char *Text){
+    if(!isValid(Handle)) return;
+    sDLCommand &Command = m_Commands[Handle];
+    if(Command.m_Type != DLCommand::Text) return;
+    if(Command.m_Visible) Invalidate(Command.m_Box);
+    Command.m_pData = Text;
+    setBox(Command);
+}
+
+// --------------------------------------------------------------------------
+// Invalidation des blocs recouverts par Area
+void cDisplayList::Invalidate(const sRect &Area){
+    if(m_pGFX == nullptr) return;
+    updateSize();
+    sRect Rect = Area;
+    sRect Frame = {0, 0, (int16_t)(m_BlocWidth * FRAME_GRILLE), (int16_t)(m_BlocHeight * FRAME_GRILLE)};
+    Rect.Intersect(Frame);
+    if(Rect.isEmpty()) return;
+
+    uint16_t BlocX0 = Rect.m_x0 / m_BlocWidth;
+    uint16_t BlocX1 = (Rect.m_x1 - 1) / m_BlocWidth;
+    uint16_t BlocY0 = Rect.m_y0 / m_BlocHeight;
+    uint16_t BlocY1 = (Rect.m_y1 - 1) / m_BlocHeight;
+    m_Dirty.setRect(BlocX0, BlocY0, BlocX1, BlocY1);
+}
+
+// ==========================================================================
+// Rendu
+
+// --------------------------------------------------------------------------
+// Rendu des blocs invalidés
+// En mode tuile (cGFX::InitTile) c'est la seule façon de construire l'écran
+void cDisplayList::Render(){
+    updateSize();
+    uint16_t Bloc;
+    while(m_Dirty.popBloc(Bloc)){
+        int16_t x = (Bloc % FRAME_GRILLE) * m_BlocWidth;
+        int16_t y = (Bloc / FRAME_GRILLE) * m_BlocHeight;
+        sRect Area = {x, y, (int16_t)(x + m_BlocWidth), (int16_t)(y + m_BlocHeight)};
+        if(m_pGFX->isTileMode()){
+            // Mode tuile : le bloc est construit dans la tuile puis transmis aussitôt
+            m_pGFX->beginTile(x, y);
+            Replay(Area);
+            m_pGFX->endTile();
+        }else{
+            Replay(Area);
+        }
+    }
+}
+
+// --------------------------------------------------------------------------
+// Effacement de Area puis rendu des commandes qui la recouvrent
+// Les commandes sont rejouées dans l'ordre d'enregistrement
+void cDisplayList::Replay(const sRect &Area){
+    if(!m_pGFX->pushClip(Area.m_x0, Area.m_y0, Area.m_x1 - Area.m_x0, Area.m_y1 - Area.m_y0)) return;
+    m_pGFX->drawFillRect(Area.m_x0, Area.m_y0, Area.m_x1 - Area.m_x0, Area.m_y1 - Area.m_y0, m_BackColor);
+    for(uint16_t Index = 0; Index < m_NbCommands; Index++){
+        sDLCommand &Command = m_Commands[Index];
+        if(Command.m_Visible && Command.m_Box.Overlaps(Area)){
+            drawCommand(Command);
+        }
+    }
+    m_pGFX->popClip();
+}
+
+// --------------------------------------------------------------------------
+// Tracé d'une commande
+void cDisplayList::drawCommand(sDLCommand &Command){
+    int16_t *p = Command.m_Param;
+    cColor Color = Command.m_Color;
+    switch(Command.m_Type){
+        case DLCommand::FillRect :
+            m_pGFX->drawFillRect(p[0], p[1], p[2], p[3], Color);
+            break;
+        case DLCommand::Rect :
+            m_pGFX->drawRect(p[0], p[1], p[2], p[3], Color);
+            break;
+        case DLCommand::Line :
+            m_pGFX->drawLine(p[0], p[1], p[2], p[3], Color);
+            break;
+        case DLCommand::Circle :
+            m_pGFX->drawCircle(p[0], p[1], p[2], Color);
+            break;
+        case DLCommand::Arc :
+            m_pGFX->drawArc(p[0], p[1], p[2], p[3], p[4], Color);
+            break;
+        case DLCommand::FillCircle :
+            m_pGFX->drawFillCircle(p[0], p[1], p[2], Color);
+            break;
+        case DLCommand::FillEllipse :
+            m_pGFX->drawFillEllipse(p[0], p[1], p[2], p[3], Color);
+            break;
+        case DLCommand::FillRoundRect :
+            m_pGFX->drawFillRoundRect(p[0], p[1], p[2], p[3], p[4], Color);
+            break;
+        case DLCommand::FillArc :
+            m_pGFX->drawFillArc(p[0], p[1], p[2], p[3], p[4], p[5], Color);
+            break;
+        case DLCommand::AALine :
+            m_pGFX->drawAALine(p[0], p[1], p[2], p[3], Color);
+            break;
+        case DLCommand::AACircle :
+            m_pGFX->drawAACircle(p[0], p[1], p[2], Color);
+            break;
+        case DLCommand::Image :
+            m_pGFX->drawImage(p[0], p[1], *(cImage *)Command.m_pData);
+            break;
+        case DLCommand::Text : {
+            // L'état texte de cGFX est rétabli après le tracé
+            cFont *pFont = m_pGFX->getFont();
+            cColor FrontColor = m_pGFX->getTextFrontColor();
+            int16_t xCursor = m_pGFX->getXCursor();
+            int16_t yCursor = m_pGFX->getYCursor();
+            m_pGFX->setFont(Command.m_pFont);
+            m_pGFX->setTextFrontColor(Color);
+            m_pGFX->setCursor(p[0], p[1]);
+            m_pGFX->drawTransText((const char *)Command.m_pData);
+            m_pGFX->setFont(pFont);
+            m_pGFX->setTextFrontColor(FrontColor);
+            m_pGFX->setCursor(xCursor, yCursor);
+            break;
+        }
+    }
+}
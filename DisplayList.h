@@ -0,0 +1,141 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2024 Dad Design.
+//      Liste d'affichage (mode retenu)
+//
+//      Les opérations de dessin sont enregistrées dans un tableau de taille
+//      fixe avec leur boite englobante. Lorsqu'une commande est modifiée, seuls
+//      les blocs couverts par son ancienne et sa nouvelle boite sont invalidés.
+//      Au rendu, chaque bloc invalidé est effacé puis seules les commandes qui
+//      le recouvrent sont rejouées, limitées à ce bloc.
+//------------------------------------------------------------------------
+#pragma once
+#include "GFX.h"
+
+// Nombre max de commandes d'une liste d'affichage
+// Peut être redéfinie dans UserConfig.h
+#ifndef DISPLAY_LIST_SIZE
+    #define DISPLAY_LIST_SIZE 64
+#endif
+
+//***********************************************************************************
+// Commandes de la liste d'affichage
+//***********************************************************************************
+enum class DLCommand : uint8_t {
+    FillRect,
+    Rect,
+    Line,
+    Circle,
+    Arc,
+    FillCircle,
+    FillEllipse,
+    FillRoundRect,
+    FillArc,
+    AALine,
+    AACircle,
+    Image,
+    Text
+};
+
+// Une commande enregistrée
+struct sDLCommand {
+    DLCommand   m_Type = DLCommand::FillRect;
+    bool        m_Visible = true;
+    sRect       m_Box = {0, 0, 0, 0};       // Boite englobante
+    cColor      m_Color = cColor(0, 0, 0);
+    int16_t     m_Param[6] = {0};           // Paramètres de la primitive (coordonnées en tête)
+    const void *m_pData = nullptr;          // Image ou texte (non copiés)
+    cFont      *m_pFont = nullptr;          // Fonte du texte
+};
+
+// Identifiant d'une commande (-1 : liste pleine)
+typedef int16_t DLHandle;
+
+//***********************************************************************************
+// cDisplayList
+// Les images et les textes ne sont pas copiés, ils doivent rester valides tant
+// que la commande existe.
+//***********************************************************************************
+class cDisplayList {
+public:
+    // --------------------------------------------------------------------------
+    // Initialisation : liste vide, toute la surface est invalidée
+    void Init(cGFX *pGFX, cColor BackColor);
+
+    // Suppression de toutes les commandes, toute la surface est invalidée
+    void Clear();
+
+    // ==========================================================================
+    // Enregistrement des commandes (mêmes paramètres que les primitives de cGFX)
+    // ==========================================================================
+    DLHandle addFillRect(int16_t x, int16_t y, int16_t dx, int16_t dy, cColor Color);
+    DLHandle addRect(int16_t x, int16_t y, int16_t dx, int16_t dy, cColor Color);
+    DLHandle addLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, cColor Color);
+    DLHandle addCircle(int16_t centerX, int16_t centerY, uint16_t radius, cColor Color);
+    DLHandle addArc(int16_t centerX, int16_t centerY, uint16_t radius, uint16_t AlphaIn, uint16_t AlphaOut, cColor Color);
+    DLHandle addFillCircle(int16_t centerX, int16_t centerY, uint16_t radius, cColor Color);
+    DLHandle addFillEllipse(int16_t centerX, int16_t centerY, uint16_t radiusX, uint16_t radiusY, cColor Color);
+    DLHandle addFillRoundRect(int16_t x, int16_t y, int16_t dx, int16_t dy, uint16_t radius, cColor Color);
+    DLHandle addFillArc(int16_t centerX, int16_t centerY, uint16_t innerRadius, uint16_t outerRadius,
+                        uint16_t AlphaIn, uint16_t AlphaOut, cColor Color);
+    DLHandle addAALine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, cColor Color);
+    DLHandle addAACircle(int16_t centerX, int16_t centerY, uint16_t radius, cColor Color);
+    DLHandle addImage(int16_t x, int16_t y, cImage *pImage);
+    DLHandle addText(int16_t x, int16_t y, const char *Text, cFont *pFont, cColor Color);
+
+    // ==========================================================================
+    // Modification des commandes
+    // ==========================================================================
+    // Changement de couleur
+    void setColor(DLHandle Handle, cColor Color);
+
+    // Affichage / masquage
+    void setVisible(DLHandle Handle, bool Visible);
+
+    // Déplacement relatif
+    void Move(DLHandle Handle, int16_t dx, int16_t dy);
+
+    // Changement du texte d'une commande Text
+    void setText(DLHandle Handle, const char *Text);
+
+    // Invalidation d'une zone (ex : données d'une image modifiées)
+    void Invalidate(const sRect &Area);
+
+    // ==========================================================================
+    // Rendu
+    // ==========================================================================
+    // Rendu des blocs invalidés dans la frame
+    // En mode tuile les blocs sont construits et transmis un par un
+    // Après un quart de tour (cGFX::setRotation()) toute la surface est redessinée
+    void Render();
+
+    // Effacement de Area puis rendu des commandes qui la recouvrent, limitées à Area
+    void Replay(const sRect &Area);
+
+protected:
+    // Enregistrement d'une commande
+    DLHandle addCommand(DLCommand Type, cColor Color, const int16_t *pParam, uint8_t NbParam,
+                        const void *pData = nullptr, cFont *pFont = nullptr);
+
+    // Calcul de la boite englobante d'une commande
+    void setBox(sDLCommand &Command);
+
+    // Mise à jour de la taille des blocs après un changement d'orientation
+    void updateSize();
+
+    // Tracé d'une commande
+    void drawCommand(sDLCommand &Command);
+
+    // Test de validité d'un identifiant
+    inline bool isValid(DLHandle Handle){
+        return (Handle >= 0) && (Handle < (DLHandle)m_NbCommands);
+    }
+
+    sDLCommand  m_Commands[DISPLAY_LIST_SIZE];
+    uint16_t    m_NbCommands = 0;
+    cDirtyMap   m_Dirty;                    // Blocs à redessiner
+
+    cGFX       *m_pGFX = nullptr;
+    uint16_t    m_BlocWidth = 0;
+    uint16_t    m_BlocHeight = 0;
+    cColor      m_BackColor = cColor(0, 0, 0);
+};
@@ -5,6 +5,7 @@
 //      Lorsqu'un Bloc est modififé il est placé dans un FIFO 
 //      et transmis automatiquement à l'écran via SPI en DMA.
 //------------------------------------------------------------------------
+#include <algorithm>
 #include "Debug.h"
 #include "daisy.h"
 #include "Frame.h"
@@ -20,6 +21,8 @@
 void cRBG_Frame::setFrame(RGB *pFrameBuff,  FIFO_Data *pFIFO_Data, uint16_t Width,  uint16_t Height){
     Init_TFT_SPI();
     m_pFrame = pFrameBuff;
+    m_pFrameBuff = pFrameBuff;
+    m_pDrawChange = &m_BlocChange;
     m_pFIFO = pFIFO_Data;
     m_Width = Width;
     m_InitWidth = Width;
@@ -33,13 +36,31 @@ void cRBG_Frame::setFrame(RGB *pFrameBuff,  FIFO_Data *pFIFO_Data, uint16_t Widt
     InitBlocs();
 }
 
+// --------------------------------------------------------------------------
+// Initialisation en mode tuile
+// La mémoire nécessaire se limite à la tuile et aux buffers de transmission du FIFO
+void cRBG_Frame::setTileFrame(RGB *pTile,  FIFO_Data *pFIFO_Data, uint16_t Width,  uint16_t Height){
+    m_TileMode = true;
+    setFrame(pTile, pFIFO_Data, Width, Height);
+}
+
 // --------------------------------------------------------------------------
 // Configuration l'orientation de la frame et de l'écran
+// La frame redevient la destination du dessin.
+// Aucune attente ni transmission : l'orientation de l'écran (MADCTL) est ajoutée
+// au FIFO au début de la transmission suivante, qui renvoie toute la frame.
+//   - Demi-tour (0 <-> 180, 90 <-> 270) : les dimensions sont conservées, le contenu
+//     de la frame et des calques est conservé et renvoyé par le FlushFrame() suivant
+//   - Quart de tour : la frame est effacée, les calques sont redimensionnés et effacés.
+//     Sans calque, rien n'est envoyé (l'écran garde l'ancienne image) tant que
+//     l'application n'a pas dessiné : la nouvelle frame est alors envoyée entière.
 void cRBG_Frame::setFrameRotation (Rotation r){
-    while(m_Busy==true){
-        Delay(1);
-    }
-    setTFTRotation(r);
+    resetScroll();
+    uint16_t OldWidth = m_Width;
+    m_pFrame = m_pFrameBuff;
+    m_pDrawChange = &m_BlocChange;
+    m_Rotation = r;
+    m_RotationPending = true;
     switch (r) {
     case Rotation::Degre_0 :   // Portrait
     case Rotation::Degre_180 : // Inverter portrait
@@ -51,30 +72,76 @@ void cRBG_Frame::setFrameRotation (Rotation r){
         setLandscape();
         break;
     }
+
+    if(m_TileMode){
+        InitBlocs();
+        return;
+    }
+    if(m_Width != OldWidth){
+        m_Stride = m_Width;
+        ClearFrame();
+        for(uint8_t Index = 0; Index < m_NbLayers; Index++){
+            m_pLayers[Index]->setSize(m_Width, m_Height);
+        }
+        m_BlocChange.Clear();
+        m_RedrawPending = true;
+    }else{
+        m_BlocChange.setAll();
+    }
+}
+
+// --------------------------------------------------------------------------
+// Envoi de l'orientation à l'écran par le FIFO, avant les fenêtres qui suivent
+void cRBG_Frame::applyRotation(){
+    m_Madctl = getMADCTL(m_Rotation);
+    AddCommand(TFT_MADCTL, &m_Madctl, 1);
+    m_RotationPending = false;
 }
+
 // ---------------------------------------------------------------------------
 // Initialisation des bloc
-//   configure pour chaque pixel l'adresse du bloc correspondant
-//   Doit être appelé pour chaque changement de d'orientation (Rotation)
+//   efface la frame et la transmet entièrement
 //   
 void cRBG_Frame::InitBlocs(){  
-    RGB *pFrame = m_pFrame;
-    for(uint16_t y =0; y < m_Height ; y ++){
-        for(uint16_t x = 0; x < m_Width ; x++){
-            uint16_t Bloc = (x/m_BlocWidth)+((y/m_BlocHeight)*(FRAME_GRILLE));
-            pFrame->m_pChange = &m_BlocChange[Bloc];
-            pFrame->B = 0;
-            pFrame->G = 0;
-            pFrame->R = 0;
-            pFrame++;
+    m_OriginX = 0;
+    m_OriginY = 0;
+    if(m_TileMode){
+        // Mode tuile : aucun bloc n'est marqué, l'écran est transmis bloc par
+        // bloc par endTile()
+        m_Stride = m_BlocWidth;
+        m_TileActive = false;
+        RGB *pTile = m_pFrame;
+        for(uint32_t Index = 0; Index < (uint32_t)(m_BlocWidth * m_BlocHeight); Index++){
+            pTile->B = 0;
+            pTile->G = 0;
+            pTile->R = 0;
+            pTile->A = 255;
+            pTile++;
         }
+        m_BlocChange.Clear();
+        return;
     }
-    for(uint8_t IndexBloc=0; IndexBloc < NB_BLOC; IndexBloc++){
-        m_BlocChange[IndexBloc]= true;
-    }
+
+    m_Stride = m_Width;
+    ClearFrame();
+    m_BlocChange.setAll();
     FlushFrame();
 }
 
+// ---------------------------------------------------------------------------
+// Effacement de la mémoire de frame (noir opaque), aucun bloc n'est marqué
+void cRBG_Frame::ClearFrame(){
+    syncAccel();
+    RGB *pFrame = m_pFrameBuff;
+    for(uint32_t Index = 0; Index < ((uint32_t)m_Width * m_Height); Index++){
+        pFrame->B = 0;
+        pFrame->G = 0;
+        pFrame->R = 0;
+        pFrame->A = 255;
+        pFrame++;
+    }
+}
+
 // --------------------------------------------------------------------------
 // Configuration de la frame en mode portrait
 void cRBG_Frame::setPortrait(){
@@ -82,7 +149,6 @@ void cRBG_Frame::setPortrait(){
     m_Width = m_InitWidth;
     m_BlocHeight = m_InitBlocHeight;
     m_BlocWidth = m_InitBlocWidth;
-    InitBlocs();
 }
 
 // --------------------------------------------------------------------------
@@ -92,43 +158,439 @@ void cRBG_Frame::setLandscape(){
     m_Width = m_InitHeight;
     m_BlocHeight = m_InitBlocWidth;
     m_BlocWidth = m_InitBlocHeight;
-    InitBlocs();
 }
 
 // --------------------------------------------------------------------------
 // Transmission des modifications de la frame vers l'écran
+// Tant que l'écran n'est pas initialisé les blocs modifiés sont conservés
 void cRBG_Frame::FlushFrame(){
-    uint16_t x;
-    uint16_t y;
-    
-    for(uint16_t Bloc = 0; Bloc < NB_BLOC; Bloc++){
-        if(getBlocChange(Bloc) == true){
-            resetBlocChange(Bloc);
-            x= (Bloc % FRAME_GRILLE) * m_BlocWidth;
-            y= (Bloc / FRAME_GRILLE) * m_BlocHeight;
-        
-            while(AddBloc(x, y) == false){
-                System::DelayTicks(1);
+    if(!InitTick() || m_CanvasActive) return;
+    syncAccel();
+    if(m_NbLayers != 0){
+        ComposeLayers();
+    }
+    if(m_RedrawPending){
+        // Après un quart de tour, rien n'est envoyé avant le premier dessin
+        if(m_BlocChange.isEmpty()) return;
+        m_BlocChange.setAll();
+        m_RedrawPending = false;
+    }
+    if(m_RotationPending){
+        applyRotation();
+    }
+    if(!m_BlocChange.isEmpty()){
+        if(m_AutoBand){
+            TuneBandHeight();
+        }
+
+        // Les blocs modifiés de chaque bande sont regroupés en fenêtres
+        for(uint16_t BlocY = 0; BlocY < FRAME_GRILLE; BlocY += m_BandHeight){
+            uint16_t NbRows = ((BlocY + m_BandHeight) <= FRAME_GRILLE) ? m_BandHeight : FRAME_GRILLE - BlocY;
+            DirtyWord Mask = 0;
+            for(uint16_t Row = 0; Row < NbRows; Row++){
+                Mask |= m_BlocChange.getRow(BlocY + Row);
+            }
+            if(Mask != 0){
+                FlushBand(BlocY, NbRows, Mask, true);
+            }
+        }
+        m_BlocChange.Clear();
+    }
+
+    // Le défilement est envoyé après les lignes découvertes
+    if(m_ScrollDefPending || m_ScrollPosPending){
+        sendScroll();
+    }
+}
+
+// --------------------------------------------------------------------------
+// Hauteur des bandes de transmission (0 -> choix automatique)
+void cRBG_Frame::setBandHeight(uint8_t BandHeight){
+    m_AutoBand = (BandHeight == 0);
+    if(BandHeight == 0) BandHeight = 1;
+    if(BandHeight > FRAME_GRILLE) BandHeight = FRAME_GRILLE;
+    m_BandHeight = BandHeight;
+    m_TuneFrames = 0;
+    for(uint8_t Choice = 0; Choice < FLUSH_BAND_CHOICES; Choice++){
+        m_TuneCost[Choice] = 0;
+    }
+}
+
+// --------------------------------------------------------------------------
+// Regroupement en fenêtres des blocs modifiés d'une bande
+uint32_t cRBG_Frame::FlushBand(uint16_t BlocY, uint16_t NbRows, DirtyWord Mask, bool Send){
+    uint32_t Cost = 0;
+    uint32_t BandBytes = (uint32_t)TAILLE_BLOC * NbRows;   // Octets d'une colonne de blocs de la bande
+    int16_t First = -1;                                     // Fenêtre en cours [First, Last]
+    int16_t Last = -1;
+
+    while(true){
+        int16_t Start = -1;
+        int16_t End = -1;
+        if(Mask != 0){
+            // Suite de blocs modifiés [Start, End]
+            Start = DIRTY_CTZ(Mask);
+            DirtyWord Ones = ~(Mask >> Start);
+            End = Start + ((Ones == 0) ? (int16_t)(sizeof(DirtyWord) * 8) - Start : DIRTY_CTZ(Ones)) - 1;
+            Mask &= ~DIRTY_MASK(Start, End);
+
+            // Fusion avec la fenêtre en cours si l'écart coûte moins qu'une fenêtre
+            // (seulement si FLUSH_WINDOW_COST > BandBytes, voir Frame.h)
+            if((First >= 0) && (((uint32_t)(Start - Last - 1) * BandBytes) < FLUSH_WINDOW_COST)){
+                Last = End;
+                continue;
+            }
+        }
+
+        // Fin de la fenêtre en cours
+        if(First >= 0){
+            Cost += FLUSH_WINDOW_COST + ((uint32_t)(Last - First + 1) * BandBytes);
+            if(Send){
+                AddWindow(First * m_BlocWidth, BlocY * m_BlocHeight,
+                          (Last - First + 1) * m_BlocWidth, NbRows * m_BlocHeight);
+            }
+        }
+        if(Start < 0) break;
+        First = Start;
+        Last = End;
+    }
+    return Cost;
+}
+
+// --------------------------------------------------------------------------
+// Choix automatique de la hauteur des bandes
+// Le coût de chaque hauteur candidate est évalué sur les blocs modifiés de chaque
+// transmission, la hauteur la moins coûteuse est retenue toutes les FLUSH_TUNE_FRAMES
+void cRBG_Frame::TuneBandHeight(){
+    for(uint8_t Choice = 0; Choice < FLUSH_BAND_CHOICES; Choice++){
+        uint16_t BandHeight = 1 << Choice;
+        if(BandHeight > FRAME_GRILLE) break;
+        for(uint16_t BlocY = 0; BlocY < FRAME_GRILLE; BlocY += BandHeight){
+            uint16_t NbRows = ((BlocY + BandHeight) <= FRAME_GRILLE) ? BandHeight : FRAME_GRILLE - BlocY;
+            DirtyWord Mask = 0;
+            for(uint16_t Row = 0; Row < NbRows; Row++){
+                Mask |= m_BlocChange.getRow(BlocY + Row);
+            }
+            if(Mask != 0){
+                m_TuneCost[Choice] += FlushBand(BlocY, NbRows, Mask, false);
             }
-            sendDMA();
         }
     }
+
+    if(++m_TuneFrames < FLUSH_TUNE_FRAMES) return;
+    uint8_t Best = 0;
+    for(uint8_t Choice = 0; Choice < FLUSH_BAND_CHOICES; Choice++){
+        if((1 << Choice) > FRAME_GRILLE) break;
+        if(m_TuneCost[Choice] < m_TuneCost[Best]) Best = Choice;
+        m_TuneCost[Choice] = 0;
+    }
+    m_BandHeight = 1 << Best;
+    m_TuneFrames = 0;
+}
+// --------------------------------------------------------------------------
+// Marque comme modifiés les blocs recouverts par Rect
+// (blocs de la destination du dessin : frame ou calque)
+void cRBG_Frame::setRectChange(const sRect &Rect){
+    sRect Area = Rect;
+    sRect Frame = {0, 0, (int16_t)m_Width, (int16_t)m_Height};
+    Area.Intersect(Frame);
+    if(Area.isEmpty() || m_TileMode) return;
+
+    uint16_t BlocX0 = Area.m_x0 / m_BlocWidth;
+    uint16_t BlocX1 = (Area.m_x1 - 1) / m_BlocWidth;
+    int16_t Top = m_ScrollTop;
+    int16_t End = m_ScrollTop + m_ScrollHeight;
+    if((m_ScrollOffset == 0) || (Area.m_y0 >= End) || (Area.m_y1 <= Top)){
+        setRowsChange(BlocX0, BlocX1, Area.m_y0, Area.m_y1);
+        return;
+    }
+
+    // Zone de défilement : les lignes de la zone sont marquées à leur place en mémoire
+    if(Area.m_y0 < Top) setRowsChange(BlocX0, BlocX1, Area.m_y0, Top);
+    if(Area.m_y1 > End) setRowsChange(BlocX0, BlocX1, End, Area.m_y1);
+    int16_t y0 = (Area.m_y0 > Top) ? Area.m_y0 : Top;
+    int16_t y1 = (Area.m_y1 < End) ? Area.m_y1 : End;
+    int16_t Start = getScrollRow(y0);
+    int16_t Stop = Start + (y1 - y0);
+    if(Stop <= End){
+        setRowsChange(BlocX0, BlocX1, Start, Stop);
+    }else{
+        setRowsChange(BlocX0, BlocX1, Start, End);
+        setRowsChange(BlocX0, BlocX1, Top, Top + (Stop - End));
+    }
+}
+
+// --------------------------------------------------------------------------
+// Définition de la zone de défilement vertical
+bool cRBG_Frame::setScrollArea(uint16_t Top, uint16_t Height){
+    if(m_TileMode || (m_NbLayers != 0) || (((uint32_t)Top + Height) > m_Height)) return false;
+    resetScroll();
+    if(Height == 0) return true;
+
+    // Le défilement par l'écran se fait selon ses lignes mémoire : impossible en paysage
+    uint8_t Madctl = m_RotationPending ? getMADCTL(m_Rotation) : m_Madctl;
+    m_ScrollTop = Top;
+    m_ScrollHeight = Height;
+    m_ScrollOffset = 0;
+    m_ScrollHard = (Madctl & TFT_MAD_MV) == 0;
+    if(m_ScrollHard){
+        m_ScrollDefPending = true;
+        m_ScrollPosPending = true;
+    }
+    return true;
 }
+
+// --------------------------------------------------------------------------
+// Défilement de la zone de défilement
+void cRBG_Frame::scrollArea(int16_t Lines){
+    if(m_ScrollHeight == 0) return;
+    int32_t Shift = Lines % (int32_t)m_ScrollHeight;
+    if(Shift < 0) Shift += m_ScrollHeight;
+    if(Shift == 0) return;
+
+    if(m_ScrollHard){
+        // Seule la position de l'anneau change, en mémoire comme dans l'écran
+        m_ScrollOffset = (m_ScrollOffset + Shift) % m_ScrollHeight;
+        m_ScrollPosPending = true;
+    }else{
+        // Déplacement des lignes dans la frame, toute la zone est transmise
+        syncAccel();
+        RGB *pFirst = &m_pFrameBuff[m_ScrollTop * m_Width];
+        std::rotate(pFirst, pFirst + (Shift * m_Width), pFirst + (m_ScrollHeight * m_Width));
+        setRowsChange(0, FRAME_GRILLE - 1, m_ScrollTop, m_ScrollTop + m_ScrollHeight);
+    }
+}
+
+// --------------------------------------------------------------------------
+// Remise des lignes de la zone de défilement dans l'ordre de la frame
+// Les lignes de l'écran restent dans l'ordre de l'anneau : la zone est transmise
+void cRBG_Frame::resetScroll(){
+    if(m_ScrollOffset != 0){
+        syncAccel();
+        RGB *pFirst = &m_pFrameBuff[m_ScrollTop * m_Width];
+        std::rotate(pFirst, pFirst + (m_ScrollOffset * m_Width), pFirst + (m_ScrollHeight * m_Width));
+        m_BlocChange.setRect(0, m_ScrollTop / m_BlocHeight, FRAME_GRILLE - 1,
+                             (m_ScrollTop + m_ScrollHeight - 1) / m_BlocHeight);
+    }
+    if(m_ScrollHard){
+        m_ScrollDefPending = true;
+        m_ScrollPosPending = true;
+    }
+    m_ScrollTop = 0;
+    m_ScrollHeight = 0;
+    m_ScrollOffset = 0;
+    m_ScrollHard = false;
+}
+
+// --------------------------------------------------------------------------
+// Envoi à l'écran de la zone et de la position de défilement
+// Les valeurs sont exprimées en lignes de la mémoire de l'écran, inversées si
+// l'orientation inverse les lignes (MY). Sans zone, toute la mémoire défile
+// avec un décalage nul.
+void cRBG_Frame::sendScroll(){
+    bool Mirror = (m_Madctl & TFT_MAD_MY) != 0;
+    uint16_t Top = m_ScrollHard ? m_ScrollTop : 0;
+    uint16_t Height = m_ScrollHard ? m_ScrollHeight : TFT_GRAM_HEIGHT;
+    uint16_t Offset = m_ScrollHard ? m_ScrollOffset : 0;
+    uint16_t TFA = Mirror ? TFT_GRAM_HEIGHT - Top - Height : Top;
+    uint16_t BFA = TFT_GRAM_HEIGHT - TFA - Height;
+
+    if(m_ScrollDefPending){
+        uint8_t Data[6] = {(uint8_t)(TFA >> 8), (uint8_t)TFA, (uint8_t)(Height >> 8), (uint8_t)Height,
+                           (uint8_t)(BFA >> 8), (uint8_t)BFA};
+        AddCommand(TFT_VSCRDEF, Data, 6);
+        m_ScrollDefPending = false;
+    }
+    if(m_ScrollPosPending){
+        uint16_t Start = TFA + (Mirror ? ((Height - Offset) % Height) : Offset);
+        uint8_t Data[2] = {(uint8_t)(Start >> 8), (uint8_t)Start};
+        AddCommand(TFT_VSCRSADD, Data, 2);
+        m_ScrollPosPending = false;
+    }
+}
+
+// --------------------------------------------------------------------------
+// Ajout d'un calque au dessus des précédents
+bool cRBG_Frame::addLayer(cLayer *pLayer){
+    if((m_NbLayers >= LAYER_MAX) || m_TileMode || (m_ScrollHeight != 0)) return false;
+    if((pLayer->m_Width != m_Width) || (pLayer->m_Height != m_Height)) return false;
+    m_pLayers[m_NbLayers++] = pLayer;
+    pLayer->setAllChanged();
+    return true;
+}
+
+// --------------------------------------------------------------------------
+// Sélection de la destination du dessin : un calque ou la frame (nullptr)
+// Le dessin dans un calque marque les blocs du calque, la frame n'est modifiée
+// qu'au moment de la composition
+void cRBG_Frame::setDrawLayer(cLayer *pLayer){
+    // Canevas sélectionné : le calque sera la destination au retour du canevas
+    sDrawState *pState = m_CanvasActive ? &m_SavedState : nullptr;
+    RGB *pFrame = (pLayer != nullptr) ? pLayer->m_pPixels : m_pFrameBuff;
+    cDirtyMap *pChange = (pLayer != nullptr) ? &pLayer->m_BlocChange : &m_BlocChange;
+    if(pState != nullptr){
+        pState->m_pFrame = pFrame;
+        pState->m_pDrawChange = pChange;
+    }else{
+        m_pFrame = pFrame;
+        m_pDrawChange = pChange;
+    }
+}
+
 // --------------------------------------------------------------------------
-// Ajout d'un bloc dans le FIFO
-bool  cRBG_Frame::AddBloc( uint16_t x, uint16_t y){
+// Sélection d'un canevas comme destination du dessin
+// Le canevas est vu comme une frame de Width * Height pixels sans zone de
+// défilement. Ses blocs (au plus FRAME_GRILLE x FRAME_GRILLE) sont marqués dans
+// m_CanvasChange, qui n'est jamais transmis.
+void cRBG_Frame::setDrawCanvas(RGB *pBuff, uint16_t Width, uint16_t Height){
+    if(pBuff == nullptr){
+        if(!m_CanvasActive) return;
+        m_pFrame = m_SavedState.m_pFrame;
+        m_pDrawChange = m_SavedState.m_pDrawChange;
+        m_OriginX = m_SavedState.m_OriginX;
+        m_OriginY = m_SavedState.m_OriginY;
+        m_Stride = m_SavedState.m_Stride;
+        m_Width = m_SavedState.m_Width;
+        m_Height = m_SavedState.m_Height;
+        m_BlocWidth = m_SavedState.m_BlocWidth;
+        m_BlocHeight = m_SavedState.m_BlocHeight;
+        m_ScrollHeight = m_SavedState.m_ScrollHeight;
+        m_ScrollOffset = m_SavedState.m_ScrollOffset;
+        m_TileMode = m_SavedState.m_TileMode;
+        m_CanvasActive = false;
+        return;
+    }
+
+    if(!m_CanvasActive){
+        m_SavedState.m_pFrame = m_pFrame;
+        m_SavedState.m_pDrawChange = m_pDrawChange;
+        m_SavedState.m_OriginX = m_OriginX;
+        m_SavedState.m_OriginY = m_OriginY;
+        m_SavedState.m_Stride = m_Stride;
+        m_SavedState.m_Width = m_Width;
+        m_SavedState.m_Height = m_Height;
+        m_SavedState.m_BlocWidth = m_BlocWidth;
+        m_SavedState.m_BlocHeight = m_BlocHeight;
+        m_SavedState.m_ScrollHeight = m_ScrollHeight;
+        m_SavedState.m_ScrollOffset = m_ScrollOffset;
+        m_SavedState.m_TileMode = m_TileMode;
+        m_CanvasActive = true;
+    }
+    m_pFrame = pBuff;
+    m_pDrawChange = &m_CanvasChange;
+    m_OriginX = 0;
+    m_OriginY = 0;
+    m_Stride = Width;
+    m_Width = Width;
+    m_Height = Height;
+    m_BlocWidth = (Width + FRAME_GRILLE - 1) / FRAME_GRILLE;
+    m_BlocHeight = (Height + FRAME_GRILLE - 1) / FRAME_GRILLE;
+    m_ScrollHeight = 0;
+    m_ScrollOffset = 0;
+    m_TileMode = false;
+    m_CanvasChange.Clear();
+}
+
+// --------------------------------------------------------------------------
+// Composition des calques dans les blocs modifiés de la frame
+// Un bloc est composé si il a été modifié dans au moins un calque
+void cRBG_Frame::ComposeLayers(){
+    cDirtyMap Change;
+    Change.Clear();
+    for(uint8_t Index = 0; Index < m_NbLayers; Index++){
+        Change.Take(m_pLayers[Index]->m_BlocChange);
+    }
+    uint16_t Bloc;
+    while(Change.popBloc(Bloc)){
+        ComposeBloc(Bloc);
+        m_BlocChange.set(Bloc % FRAME_GRILLE, Bloc / FRAME_GRILLE);
+    }
+}
+
+// --------------------------------------------------------------------------
+// Composition des calques dans un bloc de la frame
+// Les composantes des calques sont prémultipliées : C = Cs + C * (255 - As) / 255
+// Le fond de la composition est noir.
+void cRBG_Frame::ComposeBloc(uint16_t Bloc){
+    uint16_t x = (Bloc % FRAME_GRILLE) * m_BlocWidth;
+    uint16_t y = (Bloc / FRAME_GRILLE) * m_BlocHeight;
+
+    for(uint16_t PosY = y; PosY < (y + m_BlocHeight); PosY++){
+        uint32_t Offset = x + (PosY * m_Width);
+        RGB *pDest = &m_pFrameBuff[Offset];
+        for(uint16_t PosX = 0; PosX < m_BlocWidth; PosX++){
+            uint16_t R = 0;
+            uint16_t G = 0;
+            uint16_t B = 0;
+            for(uint8_t Index = 0; Index < m_NbLayers; Index++){
+                cLayer *pLayer = m_pLayers[Index];
+                if(!pLayer->m_Visible) continue;
+                RGB *pSrc = &pLayer->m_pPixels[Offset + PosX];
+                if(pSrc->A == 255){
+                    R = pSrc->R;
+                    G = pSrc->G;
+                    B = pSrc->B;
+                }else if(pSrc->A != 0){
+                    uint16_t invAlpha = 255 - pSrc->A;
+                    R = pSrc->R + ((R * invAlpha) / 255);
+                    G = pSrc->G + ((G * invAlpha) / 255);
+                    B = pSrc->B + ((B * invAlpha) / 255);
+                }
+            }
+            pDest->R = R;
+            pDest->G = G;
+            pDest->B = B;
+            pDest->A = 255;
+            pDest++;
+        }
+    }
+}
+
+// --------------------------------------------------------------------------
+// Début de construction d'un bloc en mode tuile
+// Les coordonnées de la frame sont translatées vers la tuile
+void cRBG_Frame::beginTile(uint16_t x, uint16_t y){
+    m_OriginX = x;
+    m_OriginY = y;
+    m_TileActive = true;
+}
+
+// --------------------------------------------------------------------------
+// Fin de construction d'un bloc en mode tuile
+// Le bloc est converti au format de l'écran dans le FIFO puis transmis,
+// la tuile est ensuite disponible pour le bloc suivant
+void cRBG_Frame::endTile(){
+    if(!m_TileActive) return;
+    m_TileActive = false;
+    Initialise();       // La tuile n'est pas conservée : l'écran doit être prêt
+    AddWindow(m_OriginX, m_OriginY, m_BlocWidth, m_BlocHeight);
+}
+
+// --------------------------------------------------------------------------
+// Ajout d'une partie d'une fenêtre dans le FIFO
+// Les morceaux suivants d'une fenêtre sont transmis sans commande : le contrôleur
+// poursuit l'écriture de la mémoire (RAMWR) tant qu'aucune autre commande n'est reçue
+bool  cRBG_Frame::AddChunk(uint16_t x, uint16_t y, uint16_t Width, uint16_t Height, uint32_t Offset, uint32_t Count,
+                           bool Solid){
     __disable_irq();
     if(m_FIFO_NbElements >= SIZE_FIFO){
         __enable_irq();
         return false;
     }
     __enable_irq();
-    uint16_t dx = x + m_BlocWidth-1;
-    uint16_t dy = y + m_BlocHeight-1;
 
-    m_pFIFO->m_CmdCASET[m_FIFO_in].setData(x, dx);
-    m_pFIFO->m_CmdRASET[m_FIFO_in].setData(y, dy);
-    m_pFIFO->m_CmdRAWWR[m_FIFO_in].setData(x, y, dx, dy, this);
+    if(Offset == 0){
+        m_pFIFO->m_CmdCASET[m_FIFO_in].setData(x, x + Width - 1);
+        m_pFIFO->m_CmdRASET[m_FIFO_in].setData(y, y + Height - 1);
+    }
+    m_pFIFO->m_CmdRAWWR[m_FIFO_in].m_Commande = TFT_RAMWR;
+    m_pFIFO->m_CmdRAWWR[m_FIFO_in].m_CmdOnly = false;
+    m_pFIFO->m_CmdRAWWR[m_FIFO_in].m_Continue = (Offset != 0);
+    if(Solid){
+        m_pFIFO->m_CmdRAWWR[m_FIFO_in].setSolid(getRawPtr(x + (Offset % Width), y + (Offset / Width)), Count);
+    }else{
+        m_pFIFO->m_CmdRAWWR[m_FIFO_in].setData(x, y, Width, Offset, Count, this);
+    }
     m_FIFO_in +=1;
     if(m_FIFO_in >= SIZE_FIFO){
         m_FIFO_in = 0;
@@ -137,6 +599,75 @@ bool  cRBG_Frame::AddBloc( uint16_t x, uint16_t y){
     return true;
 }
 
+// --------------------------------------------------------------------------
+// Ajout dans le FIFO d'une commande seule (transmise après les fenêtres en attente)
+void cRBG_Frame::AddCommand(uint8_t Commande, const uint8_t *pData, uint8_t Size){
+    while(true){
+        __disable_irq();
+        bool Full = (m_FIFO_NbElements >= SIZE_FIFO);
+        __enable_irq();
+        if(!Full) break;
+        System::DelayTicks(1);
+    }
+    m_pFIFO->m_CmdRAWWR[m_FIFO_in].setCommand(Commande, pData, Size);
+    m_FIFO_in +=1;
+    if(m_FIFO_in >= SIZE_FIFO){
+        m_FIFO_in = 0;
+    }
+    m_FIFO_NbElements+=1;
+    sendDMA();
+}
+
+// --------------------------------------------------------------------------
+// Transmission d'une fenêtre
+void cRBG_Frame::AddWindow(uint16_t x, uint16_t y, uint16_t Width, uint16_t Height){
+    if(m_RotationPending){
+        applyRotation();
+    }
+    uint32_t NbPixels = (uint32_t)Width * Height;
+    const uint32_t ChunkPixels = TAILLE_BLOC / PIXEL_SIZE;
+    uint32_t Offset = 0;
+    while(Offset < NbPixels){
+        uint32_t Count = ((NbPixels - Offset) < ChunkPixels) ? NbPixels - Offset : ChunkPixels;
+        bool Solid = false;
+        if(FLUSH_SOLID_PIXELS > 0){
+            // Une suite d'une seule couleur couvrant au moins le morceau est transmise entière
+            uint32_t Run = getSolidRun(x, y, Width, Offset, NbPixels - Offset);
+            if(Run >= Count){
+                Count = Run;
+                Solid = true;
+            }
+        }
+        while(AddChunk(x, y, Width, Height, Offset, Count, Solid) == false){
+            System::DelayTicks(1);
+        }
+        sendDMA();
+        Offset += Count;
+    }
+}
+
+// --------------------------------------------------------------------------
+// Nombre de pixels (au plus Max) de même couleur que le pixel Offset d'une fenêtre
+uint32_t cRBG_Frame::getSolidRun(uint16_t x, uint16_t y, uint16_t Width, uint32_t Offset, uint32_t Max){
+    uint16_t PosX = x + (Offset % Width);
+    uint16_t PosY = y + (Offset / Width);
+    const RGB *pRef = getRawPtr(PosX, PosY);
+    uint32_t Run = 0;
+
+    while(Run < Max){
+        uint32_t NbPixels = x + Width - PosX;
+        if(NbPixels > (Max - Run)) NbPixels = Max - Run;
+        const RGB *pPixel = getRawPtr(PosX, PosY);
+        for(uint32_t Index = 0; Index < NbPixels; Index++){
+            if(!pPixel[Index].isSameColor(*pRef)) return Run + Index;
+        }
+        Run += NbPixels;
+        PosX = x;
+        PosY++;
+    }
+    return Run;
+}
+
 // --------------------------------------------------------------------------
 // Transmission des blocs contenus dans le FIFO
 bool cRBG_Frame::sendDMA(){
@@ -150,10 +681,21 @@ bool cRBG_Frame::sendDMA(){
 
     // On lance la transmission du premier bloc à transférer
     m_Busy = true;
-    SendDMACommand(&m_pFIFO->m_CmdCASET[m_FIFO_out].m_Commande, cRBG_Frame::sendCASETDMAData, this);
+    sendFIFOEntry();
     return true;
 }
 
+// Début de transmission de l'élément de sortie du FIFO
+void cRBG_Frame::sendFIFOEntry(){
+    if(m_pFIFO->m_CmdRAWWR[m_FIFO_out].m_Continue){
+        sendRAWWRDMAData(this, daisy::SpiHandle::Result::OK);
+    }else if(m_pFIFO->m_CmdRAWWR[m_FIFO_out].m_CmdOnly){
+        sendRAWWRDMACmd(this, daisy::SpiHandle::Result::OK);
+    }else{
+        SendDMACommand(&m_pFIFO->m_CmdCASET[m_FIFO_out].m_Commande, cRBG_Frame::sendCASETDMAData, this);
+    }
+}
+
 void cRBG_Frame::sendCASETDMAData(void* context, daisy::SpiHandle::Result result){
     cRBG_Frame *pthis = (cRBG_Frame *)context;
     pthis->SendDMAData(pthis->m_pFIFO->m_CmdCASET[pthis->m_FIFO_out].m_Data, 4, cRBG_Frame::sendRASETDMACmd, context);
@@ -172,9 +714,15 @@ void cRBG_Frame::sendRAWWRDMACmd(void* context, daisy::SpiHandle::Result result)
     cRBG_Frame *pthis = (cRBG_Frame *)context;
     pthis->SendDMACommand(&pthis->m_pFIFO->m_CmdRAWWR[pthis->m_FIFO_out].m_Commande, cRBG_Frame::sendRAWWRDMAData, context);
 }
+// Les données sont émises par transferts de m_Size octets jusqu'à épuisement de m_Total
+// (un seul transfert sauf pour un motif de couleur unie)
 void cRBG_Frame::sendRAWWRDMAData(void* context, daisy::SpiHandle::Result result){
     cRBG_Frame *pthis = (cRBG_Frame *)context;
-    pthis->SendDMAData(pthis->m_pFIFO->m_CmdRAWWR[pthis->m_FIFO_out].m_Data, TAILLE_BLOC, cRBG_Frame::endDMA, context);
+    Cmd_RAMWR *pCmd = &pthis->m_pFIFO->m_CmdRAWWR[pthis->m_FIFO_out];
+    uint32_t Size = (pCmd->m_Total < pCmd->m_Size) ? pCmd->m_Total : pCmd->m_Size;
+    pCmd->m_Total -= Size;
+    pthis->SendDMAData(pCmd->m_Data, Size,
+                       (pCmd->m_Total != 0) ? cRBG_Frame::sendRAWWRDMAData : cRBG_Frame::endDMA, context);
 }
 
 // Fin de transmission du bloc
@@ -190,12 +738,63 @@ void cRBG_Frame::endDMA(void* context, daisy::SpiHandle::Result result){
 
     // Si le FIFO n'est pas vide -> Transmission du bloc suivant
     if(pthis->m_FIFO_NbElements != 0){
-        pthis->SendDMACommand(&pthis->m_pFIFO->m_CmdCASET[pthis->m_FIFO_out].m_Commande, cRBG_Frame::sendCASETDMAData, context);
+        pthis->sendFIFOEntry();
     }else{
         pthis->m_Busy = false;
     }
 };
 
+//***********************************************************************************
+// cLayer
+//*********************************************************************************** 
+
+// --------------------------------------------------------------------------
+// Initialisation : le calque est transparent
+void cLayer::Init(RGB *pBuff, uint16_t Width, uint16_t Height){
+    m_pPixels = pBuff;
+    m_Visible = true;
+    setSize(Width, Height);
+}
+
+// --------------------------------------------------------------------------
+// Dimensionnement
+void cLayer::setSize(uint16_t Width, uint16_t Height){
+    m_Width = Width;
+    m_Height = Height;
+    m_BlocWidth = Width / FRAME_GRILLE;
+    m_BlocHeight = Height / FRAME_GRILLE;
+    Clear();
+}
+
+// --------------------------------------------------------------------------
+// Effacement complet du calque
+void cLayer::Clear(){
+    RGB *pPixel = m_pPixels;
+    for(uint32_t Index = 0; Index < ((uint32_t)m_Width * m_Height); Index++){
+        pPixel->R = 0;
+        pPixel->G = 0;
+        pPixel->B = 0;
+        pPixel->A = 0;
+        pPixel++;
+    }
+    setAllChanged();
+}
+
+// --------------------------------------------------------------------------
+// Affichage / masquage du calque
+void cLayer::setVisible(bool Visible){
+    if(m_Visible != Visible){
+        m_Visible = Visible;
+        setAllChanged();
+    }
+}
+
+// --------------------------------------------------------------------------
+// Marque tous les blocs comme modifiés
+void cLayer::setAllChanged(){
+    m_BlocChange.setAll();
+}
+
 //***********************************************************************************
 // Cmd_RAMWR
 //   Commande SPI d'ecriture des pixels 
@@ -203,14 +802,24 @@ void cRBG_Frame::endDMA(void* context, daisy::SpiHandle::Result result){
 
 // --------------------------------------------------------------------------
 // Définition des pixels de la frame à transférer
-void Cmd_RAMWR::setData(uint16_t x, uint16_t y, uint16_t dx, uint16_t dy, cRBG_Frame *pFrame){
+void Cmd_RAMWR::setData(uint16_t x, uint16_t y, uint16_t Width, uint32_t Offset, uint32_t Count, cRBG_Frame *pFrame){
     RGB *pFrameCourant;
     RGB *pEndLigne;
     uint8_t *pBloc = m_Data;
+    uint16_t PosX = x + (Offset % Width);
+    uint16_t PosY = y + (Offset / Width);
+    uint32_t Remain = Count;
+    m_Size = Count * PIXEL_SIZE;
+    m_Total = m_Size;
 
-    for (uint16_t PosY = y; PosY <= dy; PosY++){
-        pFrameCourant = pFrame->getPtr(x, PosY);
-        pEndLigne = pFrame->getPtr(dx, PosY);
+    while (Remain != 0){
+        uint16_t NbPixels = x + Width - PosX;
+        if(NbPixels > Remain) NbPixels = Remain;
+        Remain -= NbPixels;
+        pFrameCourant = pFrame->getRawPtr(PosX, PosY);
+        pEndLigne = pFrameCourant + (NbPixels - 1);
+        PosX = x;
+        PosY++;
         while (pFrameCourant <= pEndLigne){
 #if TFT_COLOR == 16
                 *pBloc++ = (pFrameCourant->getR() & 0xF8) | (pFrameCourant->getG() >> 5 );
@@ -225,4 +834,40 @@ void Cmd_RAMWR::setData(uint16_t x, uint16_t y, uint16_t dx, uint16_t dy, cRBG_F
     }
 }
 
+// --------------------------------------------------------------------------
+// Définition de Count pixels de la couleur de Pixel
+void Cmd_RAMWR::setSolid(RGB *pPixel, uint32_t Count){
+    uint32_t NbPixels = (Count < SOLID_PATTERN_PIXELS) ? Count : SOLID_PATTERN_PIXELS;
+#if TFT_COLOR == 16
+    uint8_t Byte0 = (pPixel->getR() & 0xF8) | (pPixel->getG() >> 5 );
+    uint8_t Byte1 = (pPixel->getB() >> 3) | ((pPixel->getG() << 3 )  & 0xE0);
+#endif
+    uint8_t *pBloc = m_Data;
+    for(uint32_t Index = 0; Index < NbPixels; Index++){
+#if TFT_COLOR == 16
+        *pBloc++ = Byte0;
+        *pBloc++ = Byte1;
+#else
+        *pBloc++ = pPixel->getR();
+        *pBloc++ = pPixel->getG();
+        *pBloc++ = pPixel->getB();
+#endif
+    }
+    m_Size = NbPixels * PIXEL_SIZE;
+    m_Total = Count * PIXEL_SIZE;
+}
+
+// --------------------------------------------------------------------------
+// Définition d'une commande seule
+void Cmd_RAMWR::setCommand(uint8_t Commande, const uint8_t *pData, uint8_t Size){
+    m_Commande = Commande;
+    m_CmdOnly = true;
+    m_Continue = false;
+    for(uint8_t Index = 0; Index < Size; Index++){
+        m_Data[Index] = pData[Index];
+    }
+    m_Size = Size;
+    m_Total = Size;
+}
+
 
@@ -10,11 +10,63 @@
 #include "Debug.h"
 
 #define NB_BLOC (FRAME_GRILLE*FRAME_GRILLE)
+
+// Nombre max de calques composés dans la frame
+// Peut être redéfinie dans UserConfig.h
+#ifndef LAYER_MAX
+    #define LAYER_MAX 4
+#endif
+
+// Nombre de pixels d'une tuile (un bloc) pour le mode sans frame complète
+#define TILE_SIZE ((TFT_WIDTH / FRAME_GRILLE) * (TFT_HEIGHT / FRAME_GRILLE))
 #if TFT_COLOR == 16
     #define TAILLE_BLOC (TFT_WIDTH * TFT_HEIGHT * 2) / NB_BLOC
+    #define PIXEL_SIZE 2
 #else
     #define TAILLE_BLOC (TFT_WIDTH * TFT_HEIGHT * 3) / NB_BLOC
+    #define PIXEL_SIZE 3
+#endif
+
+// Transmission des blocs modifiés
+//   Les blocs modifiés d'une bande de FLUSH_BAND_HEIGHT lignes de blocs sont
+//   regroupés en fenêtres horizontales, chaque fenêtre est transmise avec une
+//   seule séquence CASET / RASET / RAMWR.
+//   FLUSH_BAND_HEIGHT = 0 -> hauteur de bande choisie automatiquement
+//   FLUSH_DMA_SETUP_BYTES : octets que le SPI aurait émis pendant la fin d'un
+//     transfert DMA et le lancement du suivant (environ 6 µs à 32 Mbit/s)
+//   FLUSH_WINDOW_COST : coût d'une fenêtre en octets. Une fenêtre ajoute les 11
+//     octets de CASET / RASET / RAMWR et 5 transferts DMA (6 au lieu d'un seul).
+//     Un écart entre deux suites de blocs modifiés est transmis avec elles s'il
+//     coûte moins qu'une fenêtre : aucune fusion tant que FLUSH_WINDOW_COST ne
+//     dépasse pas TAILLE_BLOC x hauteur de bande. Ex : écran 128x160 en 16 bits,
+//     FRAME_GRILLE 8 -> TAILLE_BLOC = 640 (pas de fusion), FRAME_GRILLE 32 -> 40.
+//   FLUSH_TUNE_FRAMES : nombre de transmissions observées avant chaque choix automatique
+// Peuvent être redéfinies dans UserConfig.h
+#ifndef FLUSH_BAND_HEIGHT
+    #define FLUSH_BAND_HEIGHT 1
+#endif
+#ifndef FLUSH_DMA_SETUP_BYTES
+    #define FLUSH_DMA_SETUP_BYTES 24
 #endif
+#ifndef FLUSH_WINDOW_COST
+    #define FLUSH_WINDOW_COST (11 + (5 * FLUSH_DMA_SETUP_BYTES))
+#endif
+#ifndef FLUSH_TUNE_FRAMES
+    #define FLUSH_TUNE_FRAMES 32
+#endif
+
+// Nombre de hauteurs de bande évaluées en mode automatique (1, 2, 4 ... 64)
+#define FLUSH_BAND_CHOICES 7
+
+// Suites de pixels d'une seule couleur
+//   Une suite d'au moins un morceau de fenêtre (TAILLE_BLOC octets) est transmise
+//   sans conversion, par DMA répétés d'un motif de FLUSH_SOLID_PIXELS pixels.
+//   FLUSH_SOLID_PIXELS = 0 -> pas de détection
+// Peut être redéfinie dans UserConfig.h
+#ifndef FLUSH_SOLID_PIXELS
+    #define FLUSH_SOLID_PIXELS 256
+#endif
+#define SOLID_PATTERN_PIXELS ((FLUSH_SOLID_PIXELS < (TAILLE_BLOC / PIXEL_SIZE)) ? FLUSH_SOLID_PIXELS : (TAILLE_BLOC / PIXEL_SIZE))
 
 //***********************************************************************************
 // Cmd_CASET
@@ -80,6 +132,8 @@ class Cmd_RASET {
 //   Commande SPI d'ecriture des pixels 
 //***********************************************************************************
 class cRBG_Frame;
+class cAccel;
+struct RGB;
 class Cmd_RAMWR {
     public :
     friend class cRBG_Frame;
@@ -92,12 +146,29 @@ class Cmd_RAMWR {
 
     // --------------------------------------------------------------------------
     // Définition des pixels de la frame à transférer
-    void setData(uint16_t x, uint16_t y, uint16_t dx, uint16_t dy, cRBG_Frame *pFrame);
+    //   Count pixels de la fenêtre de coin haut gauche x, y et de largeur Width,
+    //   à partir du pixel Offset (pixels numérotés ligne par ligne)
+    void setData(uint16_t x, uint16_t y, uint16_t Width, uint32_t Offset, uint32_t Count, cRBG_Frame *pFrame);
+
+    // --------------------------------------------------------------------------
+    // Définition de Count pixels de la couleur de Pixel
+    //   Seul le motif de SOLID_PATTERN_PIXELS pixels est converti, il est transmis
+    //   autant de fois que nécessaire
+    void setSolid(RGB *pPixel, uint32_t Count);
+
+    // --------------------------------------------------------------------------
+    // Définition d'une commande seule et de ses Size octets de paramètres
+    //   (transmise sans fenêtre CASET / RASET)
+    void setCommand(uint8_t Commande, const uint8_t *pData, uint8_t Size);
 
     // --------------------------------------------------------------------------
     // Données de la classe
     protected :
     uint8_t m_Commande;
+    bool    m_Continue = false;     // Suite des pixels de la fenêtre précédente (pas de commande)
+    bool    m_CmdOnly = false;      // Commande seule, sans fenêtre
+    uint32_t m_Size = 0;            // Nombre d'octets de m_Data à transmettre
+    uint32_t m_Total = 0;           // Nombre d'octets restant à transmettre (motif répété)
     uint8_t m_Data[TAILLE_BLOC];
 };
 
@@ -119,14 +190,201 @@ struct cColor {
     uint8_t m_A;
 };
 
+//***********************************************************************************
+// sRect
+// Rectangle [m_x0, m_x1[ x [m_y0, m_y1[
+//*********************************************************************************** 
+struct sRect {
+    int16_t m_x0;   // Abscisse du bord gauche (inclus)
+    int16_t m_y0;   // Ordonnée du bord haut (inclus)
+    int16_t m_x1;   // Abscisse du bord droit (exclu)
+    int16_t m_y1;   // Ordonnée du bord bas (exclu)
+
+    // --------------------------------------------------------------------------
+    // Test si le rectangle est vide
+    inline bool isEmpty() const {
+        return (m_x0 >= m_x1) || (m_y0 >= m_y1);
+    }
+
+    // --------------------------------------------------------------------------
+    // Intersection avec le rectangle Rect
+    inline void Intersect(const sRect &Rect){
+        if(Rect.m_x0 > m_x0) m_x0 = Rect.m_x0;
+        if(Rect.m_y0 > m_y0) m_y0 = Rect.m_y0;
+        if(Rect.m_x1 < m_x1) m_x1 = Rect.m_x1;
+        if(Rect.m_y1 < m_y1) m_y1 = Rect.m_y1;
+    }
+
+    // --------------------------------------------------------------------------
+    // Test si le rectangle a une partie commune avec Rect
+    inline bool Overlaps(const sRect &Rect) const {
+        return (Rect.m_x0 < m_x1) && (m_x0 < Rect.m_x1) && (Rect.m_y0 < m_y1) && (m_y0 < Rect.m_y1);
+    }
+
+    // --------------------------------------------------------------------------
+    // Test si le rectangle contient entièrement le rectangle [x0, x1[ x [y0, y1[
+    inline bool Contains(int16_t x0, int16_t y0, int16_t x1, int16_t y1) const {
+        return (x0 >= m_x0) && (y0 >= m_y0) && (x1 <= m_x1) && (y1 <= m_y1);
+    }
+
+    // --------------------------------------------------------------------------
+    // Union avec le rectangle Rect (plus petit rectangle contenant les deux)
+    inline void Union(const sRect &Rect){
+        if(Rect.isEmpty()) return;
+        if(isEmpty()){
+            *this = Rect;
+            return;
+        }
+        if(Rect.m_x0 < m_x0) m_x0 = Rect.m_x0;
+        if(Rect.m_y0 < m_y0) m_y0 = Rect.m_y0;
+        if(Rect.m_x1 > m_x1) m_x1 = Rect.m_x1;
+        if(Rect.m_y1 > m_y1) m_y1 = Rect.m_y1;
+    }
+
+    // --------------------------------------------------------------------------
+    // Test si le rectangle contient entièrement le rectangle Rect
+    inline bool Contains(const sRect &Rect) const {
+        return Contains(Rect.m_x0, Rect.m_y0, Rect.m_x1, Rect.m_y1);
+    }
+
+    // --------------------------------------------------------------------------
+    // Test si le rectangle contient le pixel x, y
+    inline bool Contains(int16_t x, int16_t y) const {
+        return (x >= m_x0) && (y >= m_y0) && (x < m_x1) && (y < m_y1);
+    }
+};
+
+//***********************************************************************************
+// cDirtyMap
+// Carte des blocs modifiés
+//   Un mot par ligne de blocs (un bit par bloc) et un mot de synthèse (un bit par
+//   ligne non vide). La recherche du prochain bloc modifié se fait par comptage des
+//   zéros de poids faible : le coût du parcours ne dépend que du nombre de blocs
+//   modifiés. La grille est limitée à 64 x 64 blocs.
+//*********************************************************************************** 
+#if FRAME_GRILLE > 64
+    #error "FRAME_GRILLE est limité à 64"
+#elif FRAME_GRILLE > 32
+    typedef uint64_t DirtyWord;
+    #define DIRTY_CTZ(Word) __builtin_ctzll(Word)
+#else
+    typedef uint32_t DirtyWord;
+    #define DIRTY_CTZ(Word) __builtin_ctz(Word)
+#endif
+
+// Mot dont les bits First à Last (inclus) sont à 1
+#define DIRTY_MASK(First, Last) ((DirtyWord)(((DirtyWord)2 << (Last)) - ((DirtyWord)1 << (First))))
+
+class cDirtyMap {
+    public :
+    // --------------------------------------------------------------------------
+    // Aucun bloc modifié
+    inline void Clear(){
+        for(uint8_t Row = 0; Row < FRAME_GRILLE; Row++){
+            m_Rows[Row] = 0;
+        }
+        m_Summary = 0;
+    }
+
+    // --------------------------------------------------------------------------
+    // Tous les blocs modifiés
+    inline void setAll(){
+        for(uint8_t Row = 0; Row < FRAME_GRILLE; Row++){
+            m_Rows[Row] = DIRTY_MASK(0, FRAME_GRILLE - 1);
+        }
+        m_Summary = DIRTY_MASK(0, FRAME_GRILLE - 1);
+    }
+
+    // --------------------------------------------------------------------------
+    // Marquage d'un bloc
+    inline void set(uint16_t BlocX, uint16_t BlocY){
+        m_Rows[BlocY] |= (DirtyWord)1 << BlocX;
+        m_Summary |= (DirtyWord)1 << BlocY;
+    }
+
+    // --------------------------------------------------------------------------
+    // Marquage des blocs [BlocX0, BlocX1] x [BlocY0, BlocY1] (bornes incluses)
+    inline void setRect(uint16_t BlocX0, uint16_t BlocY0, uint16_t BlocX1, uint16_t BlocY1){
+        DirtyWord Mask = DIRTY_MASK(BlocX0, BlocX1);
+        for(uint16_t BlocY = BlocY0; BlocY <= BlocY1; BlocY++){
+            m_Rows[BlocY] |= Mask;
+        }
+        m_Summary |= DIRTY_MASK(BlocY0, BlocY1);
+    }
+
+    // --------------------------------------------------------------------------
+    // Remise à zéro d'un bloc (Bloc = BlocX + BlocY * FRAME_GRILLE)
+    inline void reset(uint16_t Bloc){
+        uint16_t BlocY = Bloc / FRAME_GRILLE;
+        m_Rows[BlocY] &= ~((DirtyWord)1 << (Bloc % FRAME_GRILLE));
+        if(m_Rows[BlocY] == 0) m_Summary &= ~((DirtyWord)1 << BlocY);
+    }
+
+    // --------------------------------------------------------------------------
+    // Test si un bloc est modifié
+    inline bool get(uint16_t Bloc){
+        return (m_Rows[Bloc / FRAME_GRILLE] >> (Bloc % FRAME_GRILLE)) & 1;
+    }
+
+    // --------------------------------------------------------------------------
+    // Test si aucun bloc n'est modifié
+    inline bool isEmpty(){
+        return m_Summary == 0;
+    }
+
+    // --------------------------------------------------------------------------
+    // Lecture des blocs modifiés d'une ligne
+    inline DirtyWord getRow(uint16_t BlocY){
+        return m_Rows[BlocY];
+    }
+
+    // --------------------------------------------------------------------------
+    // Extraction du premier bloc modifié (ligne par ligne), qui est remis à zéro
+    // Retourne false si aucun bloc n'est modifié
+    inline bool popBloc(uint16_t &Bloc){
+        if(m_Summary == 0) return false;
+        uint16_t BlocY = DIRTY_CTZ(m_Summary);
+        DirtyWord &Row = m_Rows[BlocY];
+        uint16_t BlocX = DIRTY_CTZ(Row);
+        Row &= Row - 1;
+        if(Row == 0) m_Summary &= ~((DirtyWord)1 << BlocY);
+        Bloc = BlocX + (BlocY * FRAME_GRILLE);
+        return true;
+    }
+
+    // --------------------------------------------------------------------------
+    // Ajout des blocs modifiés de Map, qui est remise à zéro
+    inline void Take(cDirtyMap &Map){
+        DirtyWord Summary = Map.m_Summary;
+        while(Summary != 0){
+            uint16_t BlocY = DIRTY_CTZ(Summary);
+            Summary &= Summary - 1;
+            m_Rows[BlocY] |= Map.m_Rows[BlocY];
+            Map.m_Rows[BlocY] = 0;
+        }
+        m_Summary |= Map.m_Summary;
+        Map.m_Summary = 0;
+    }
+
+    protected :
+    DirtyWord m_Rows[FRAME_GRILLE] = {0};   // Blocs modifiés de chaque ligne
+    DirtyWord m_Summary = 0;                // Lignes contenant au moins un bloc modifié
+};
+
 //***********************************************************************************
 // RGB
 // Définition d'un pixel RGB 
+//   Les composantes sont prémultipliées par l'opacité A. Les pixels de la frame
+//   sont opaques (A = 255), seuls les pixels des calques peuvent être transparents.
+//   L'écriture d'un pixel ne marque pas son bloc : chaque primitive marque une
+//   seule fois les blocs recouverts par sa boite englobante (setRectChange).
 //*********************************************************************************** 
 struct RGB {
     friend class cRBG_Frame;
+    friend class cLayer;
+    friend class cAccel;
 	// --------------------------------------------------------------------------
-	// Mise à jour d'un pixel et indication que le bloc a changé d'état
+	// Mise à jour d'un pixel (opération "over")
     void inline set(cColor Color){
         if(Color.m_A == 0){
             return;
@@ -134,14 +392,53 @@ struct RGB {
             R = Color.m_R;
             G = Color.m_G;
             B = Color.m_B;
+            A = 255;
         }else{
             uint16_t invAlpha = 255 - Color.m_A;
             uint16_t Alpha = Color.m_A;
             R = (uint8_t) (((Alpha * (uint16_t) Color.m_R) +  (invAlpha * (uint16_t)R)) / (uint16_t)255);
             G = (uint8_t) (((Alpha * (uint16_t) Color.m_G) +  (invAlpha * (uint16_t)G)) / (uint16_t)255);
             B = (uint8_t) (((Alpha * (uint16_t) Color.m_B) +  (invAlpha * (uint16_t)B)) / (uint16_t)255);
+            A = (uint8_t) (Alpha + ((invAlpha * (uint16_t)A) / (uint16_t)255));
+        }
+    }
+
+	// --------------------------------------------------------------------------
+	// Effacement d'un pixel : noir transparent
+    void inline clear(){
+        R = 0;
+        G = 0;
+        B = 0;
+        A = 0;
+    }
+
+	// --------------------------------------------------------------------------
+	// Comparaison des couleurs de deux pixels (opacité ignorée)
+    bool inline isSameColor(const RGB &Pixel) const {
+        return (R == Pixel.R) && (G == Pixel.G) && (B == Pixel.B);
+    }
+
+	// --------------------------------------------------------------------------
+	// Copie des composantes d'un pixel (sauvegarde et restauration de fond)
+    void inline copy(const RGB &Pixel){
+        R = Pixel.R;
+        G = Pixel.G;
+        B = Pixel.B;
+        A = Pixel.A;
+    }
+
+	// --------------------------------------------------------------------------
+	// Composition d'un pixel prémultiplié par dessus (opération "over")
+    void inline over(const RGB &Pixel){
+        if(Pixel.A == 255){
+            copy(Pixel);
+        }else if(Pixel.A != 0){
+            uint16_t invAlpha = 255 - Pixel.A;
+            R = Pixel.R + ((R * invAlpha) / 255);
+            G = Pixel.G + ((G * invAlpha) / 255);
+            B = Pixel.B + ((B * invAlpha) / 255);
+            A = Pixel.A + ((A * invAlpha) / 255);
         }
-        *m_pChange = true;
     }
 
     // --------------------------------------------------------------------------
@@ -161,13 +458,65 @@ struct RGB {
         return B;
     }
 
+    // --------------------------------------------------------------------------
+	// Lecture de l'opacité 
+    uint8_t inline getA(){
+        return A;
+    }
+
     // --------------------------------------------------------------------------
     // Données de la classe
     protected :
     uint8_t R;          // Composante Rouge
     uint8_t G;          // Composante Verte
     uint8_t B;          // Composante Bleue
-    bool *m_pChange;    // Indicateur de changement d'état (pointe sur un tableau de bloc) 
+    uint8_t A;          // Opacité
+};
+
+//***********************************************************************************
+// cLayer
+//  Calque de la taille de la frame, avec son propre état de changement des blocs.
+//  Les calques ajoutés à la frame sont composés du premier (fond) au dernier
+//  (premier plan) au moment de la transmission, uniquement pour les blocs modifiés
+//  dans au moins un calque.
+//*********************************************************************************** 
+class cLayer {
+    public :
+    friend class cRBG_Frame;
+
+    // --------------------------------------------------------------------------
+    // Initialisation : le calque est transparent
+    // pBuff doit contenir Width * Height pixels
+    void Init(RGB *pBuff, uint16_t Width, uint16_t Height);
+
+    // --------------------------------------------------------------------------
+    // Effacement complet du calque (transparent)
+    void Clear();
+
+    // --------------------------------------------------------------------------
+    // Affichage / masquage du calque
+    void setVisible(bool Visible);
+
+    inline bool isVisible(){
+        return m_Visible;
+    }
+
+    protected :
+    // --------------------------------------------------------------------------
+    // Dimensionnement, le calque est effacé
+    void setSize(uint16_t Width, uint16_t Height);
+
+    // --------------------------------------------------------------------------
+    // Marque tous les blocs comme modifiés
+    void setAllChanged();
+
+    RGB         *m_pPixels = nullptr;       // Pixels du calque
+    uint16_t    m_Width = 0;
+    uint16_t    m_Height = 0;
+    uint16_t    m_BlocWidth = 0;
+    uint16_t    m_BlocHeight = 0;
+    bool        m_Visible = true;
+    cDirtyMap   m_BlocChange;               // Blocs modifiés
 };
 
 //***********************************************************************************
@@ -204,29 +553,59 @@ class cRBG_Frame  : protected TFT_SPI {
     // Initialisation de la classe.
     // Doit être appelée avant toute utilisation (aucune vérification réalisée) 
     void setFrame(RGB *pFrameBuff,  FIFO_Data *pFIFO_Data, uint16_t Width,  uint16_t Height);
+
+    // --------------------------------------------------------------------------
+    // Initialisation en mode tuile (sans frame complète)
+    //   pTile ne contient qu'un bloc (TILE_SIZE pixels). L'écran est construit bloc
+    //   par bloc entre beginTile() et endTile(), chaque bloc est converti dans un
+    //   buffer de transmission du FIFO dès qu'il est terminé.
+    void setTileFrame(RGB *pTile,  FIFO_Data *pFIFO_Data, uint16_t Width,  uint16_t Height);
     
     // --------------------------------------------------------------------------
     // Configuration l'orientation de la frame et de l'écran
+    //   Un demi-tour conserve le contenu de la frame : l'écran est réorienté et
+    //   entièrement mis à jour par le FlushFrame() suivant.
+    //   Un quart de tour efface la frame : sans calque, l'écran n'est réorienté et
+    //   mis à jour qu'au premier FlushFrame() qui suit un dessin.
     void setFrameRotation (Rotation r);
 
     // ==========================================================================
     // Lecture / Ecriture
 
     // --------------------------------------------------------------------------
-    // Retourne l'adresse d'un pixel à partir de ses coordonnées         
+    // Retourne l'adresse d'un pixel à partir de ses coordonnées
+    // Aucune vérification : les coordonnées doivent être dans la frame
     inline RGB *getPtr(int16_t x, int16_t y){
-        if(x<0) x=0;
-        if(y<0) y=0;
-        if(x>=m_Width) x = m_Width-1;
-        if(y>=m_Height) y = m_Height-1;
-        return &m_pFrame[x+(y*m_Width)];
+        syncAccel();
+        return &m_pFrame[(x - m_OriginX)+((getScrollRow(y) - m_OriginY)*m_Stride)];
+    } 
+
+    // --------------------------------------------------------------------------
+    // Retourne l'adresse d'un pixel à partir de sa ligne en mémoire
+    // (ligne de l'écran, sans le décalage de la zone de défilement)
+    inline RGB *getRawPtr(int16_t x, int16_t y){
+        syncAccel();
+        return &m_pFrame[(x - m_OriginX)+((y - m_OriginY)*m_Stride)];
     } 
 
     // --------------------------------------------------------------------------
-    // Ecriture d'un pixel 
+    // Ecart en pixels entre deux lignes de la mémoire de frame
+    inline uint16_t getStride(){
+        return m_Stride;
+    }
+
+    // --------------------------------------------------------------------------
+    // Ecriture d'un pixel (ignoré en dehors de la frame) et marquage de son bloc
     inline void setPixel(int16_t x, int16_t y, cColor Color){
-        if((x<m_Width) && (y<m_Height)){
+        syncAccel();
+        if(m_TileMode){
+            if(m_TileActive && ((uint16_t)(x - m_OriginX) < m_BlocWidth) && ((uint16_t)(y - m_OriginY) < m_BlocHeight)){
+                getPtr(x, y)->set(Color);
+            }
+        }else if(((uint16_t)x < m_Width) && ((uint16_t)y < m_Height)){
+            y = getScrollRow(y);
             m_pFrame[x+(y*m_Width)].set(Color);
+            m_pDrawChange->set(x / m_BlocWidth, y / m_BlocHeight);
         }
     }
     
@@ -247,7 +626,97 @@ class cRBG_Frame  : protected TFT_SPI {
     // --------------------------------------------------------------------------
     // Transmission des modifications de la frame vers l'écran    
     void FlushFrame();
+
+    // --------------------------------------------------------------------------
+    // Hauteur des bandes de transmission en lignes de blocs
+    // 0 -> choix automatique : toutes les FLUSH_TUNE_FRAMES transmissions, la
+    // hauteur qui aurait minimisé le coût (octets + FLUSH_WINDOW_COST par fenêtre)
+    // des transmissions observées est retenue
+    void setBandHeight(uint8_t BandHeight);
+
+    inline uint8_t getBandHeight(){
+        return m_BandHeight;
+    }
+
+    // ==========================================================================
+    // Calques
+    // --------------------------------------------------------------------------
+    // Ajout d'un calque au dessus des précédents
+    // Retourne false si le nombre max est atteint, en mode tuile, avec une zone de
+    // défilement, ou si la taille du calque est différente de celle de la frame
+    bool addLayer(cLayer *pLayer);
+
+    // --------------------------------------------------------------------------
+    // Sélection de la destination du dessin : un calque ou la frame (nullptr)
+    void setDrawLayer(cLayer *pLayer);
+
+    // ==========================================================================
+    // Dessin hors écran
+    // --------------------------------------------------------------------------
+    // Sélection d'une mémoire de Width * Height pixels comme destination du dessin
+    //   pBuff = nullptr -> retour à la destination précédente (frame ou calque)
+    //   Les coordonnées sont celles du canevas, les blocs marqués sont ignorés.
+    //   FlushFrame() est sans effet tant qu'un canevas est sélectionné.
+    void setDrawCanvas(RGB *pBuff, uint16_t Width, uint16_t Height);
+
+    inline bool isDrawCanvas(){
+        return m_CanvasActive;
+    }
+
+    // ==========================================================================
+    // Mode tuile
+    // --------------------------------------------------------------------------
+    // Test si la frame fonctionne en mode tuile
+    inline bool isTileMode(){
+        return m_TileMode;
+    }
+
+    // --------------------------------------------------------------------------
+    // Début de construction du bloc dont le coin haut gauche est x, y
+    void beginTile(uint16_t x, uint16_t y);
+
+    // --------------------------------------------------------------------------
+    // Fin de construction du bloc : conversion dans le FIFO et transmission
+    void endTile();
+
+    // ==========================================================================
+    // Défilement vertical
+    // --------------------------------------------------------------------------
+    // Définition de la zone de défilement : lignes Top à Top + Height - 1 de la frame
+    //   Height = 0 -> pas de zone de défilement
+    //   En orientation 0° ou 180° le défilement est réalisé par l'écran (VSCRDEF /
+    //   VSCRSADD) : les lignes de la zone forment un anneau en mémoire et seules les
+    //   lignes découvertes sont à transmettre. En paysage les lignes sont déplacées
+    //   dans la frame et toute la zone est transmise.
+    //   Retourne false en mode tuile, avec des calques ou si la zone sort de la frame
+    bool setScrollArea(uint16_t Top, uint16_t Height);
+
+    // --------------------------------------------------------------------------
+    // Défilement de la zone de Lines lignes (Lines > 0 : le contenu monte)
+    //   Les lignes découvertes ne sont ni effacées ni marquées
+    void scrollArea(int16_t Lines);
+
+    inline uint16_t getScrollTop(){
+        return m_ScrollTop;
+    }
+    inline uint16_t getScrollHeight(){
+        return m_ScrollHeight;
+    }
     
+    // ==========================================================================
+    // Accélération (voir Accel.h)
+    // --------------------------------------------------------------------------
+    // Sélection de l'accélérateur (nullptr -> aucun)
+    void setAccel(cAccel *pAccel);
+
+    inline cAccel *getAccel(){
+        return m_pAccel;
+    }
+
+    // --------------------------------------------------------------------------
+    // Attente de la fin de l'opération confiée à l'accélérateur
+    void waitAccel();
+
     // ==========================================================================
     // Gestion des blocs de transmission
 
@@ -283,23 +752,63 @@ class cRBG_Frame  : protected TFT_SPI {
 
     // --------------------------------------------------------------------------
     // Test si un pixel du bloc a changé d'état
-    inline bool getBlocChange(uint8_t Bloc){
-        return m_BlocChange[Bloc];
+    inline bool getBlocChange(uint16_t Bloc){
+        return m_BlocChange.get(Bloc);
     }
 
     // --------------------------------------------------------------------------
     // Remise à zéro de l'indicateur de changement d'état
-    inline void resetBlocChange(uint8_t Bloc){
-        m_BlocChange[Bloc] = false;
+    inline void resetBlocChange(uint16_t Bloc){
+        m_BlocChange.reset(Bloc);
     }
 
     // --------------------------------------------------------------------------
-    // Ajout d'un bloc dans le FIFO
-    bool AddBloc(uint16_t x, uint16_t y);
+    // Marque comme modifiés les blocs recouverts par Rect
+    void setRectChange(const sRect &Rect);
+
+    // --------------------------------------------------------------------------
+    // Composition des calques dans les blocs modifiés de la frame
+    void ComposeLayers();
+
+    // --------------------------------------------------------------------------
+    // Composition des calques dans un bloc de la frame
+    void ComposeBloc(uint16_t Bloc);
+
+    // --------------------------------------------------------------------------
+    // Ajout dans le FIFO des pixels Offset à Offset + Count - 1 d'une fenêtre
+    // Offset = 0 -> précédés des commandes CASET / RASET / RAMWR
+    // Solid = true -> pixels d'une seule couleur, transmis par répétition d'un motif
+    // Retourne false si le FIFO est plein
+    bool AddChunk(uint16_t x, uint16_t y, uint16_t Width, uint16_t Height, uint32_t Offset, uint32_t Count,
+                  bool Solid = false);
+
+    // --------------------------------------------------------------------------
+    // Transmission d'une fenêtre, découpée en morceaux de TAILLE_BLOC octets
+    // ou en suites de pixels d'une seule couleur
+    void AddWindow(uint16_t x, uint16_t y, uint16_t Width, uint16_t Height);
+
+    // --------------------------------------------------------------------------
+    // Nombre de pixels (au plus Max) de même couleur que le pixel Offset d'une fenêtre
+    uint32_t getSolidRun(uint16_t x, uint16_t y, uint16_t Width, uint32_t Offset, uint32_t Max);
+
+    // --------------------------------------------------------------------------
+    // Regroupement en fenêtres des blocs Mask d'une bande de NbRows lignes de blocs
+    // Deux fenêtres sont fusionnées si les blocs non modifiés qui les séparent
+    // coûtent moins cher qu'une fenêtre supplémentaire.
+    // Send = true : les fenêtres sont transmises. Retourne le coût de la bande.
+    uint32_t FlushBand(uint16_t BlocY, uint16_t NbRows, DirtyWord Mask, bool Send);
+
+    // --------------------------------------------------------------------------
+    // Mode automatique : cumul du coût des blocs modifiés pour chaque hauteur de
+    // bande, puis choix de la hauteur la moins coûteuse
+    void TuneBandHeight();
 
     // --------------------------------------------------------------------------
     // Transmission des blocs contenus dans le FIFO
     bool sendDMA();
+
+    // Début de transmission de l'élément de sortie du FIFO
+    void sendFIFOEntry();
     
     // Callbacks en fin de transmission DMA
     static void sendCASETDMAData(void* context, daisy::SpiHandle::Result result);
@@ -320,7 +829,60 @@ class cRBG_Frame  : protected TFT_SPI {
     // Initialisation des blocs de tansmission
     void InitBlocs();
 
-    RGB         *m_pFrame = nullptr;        // Pointe sur la mémoire de frame
+    // Effacement de la mémoire de frame
+    void ClearFrame();
+
+    // --------------------------------------------------------------------------
+    // Ligne en mémoire d'une ligne de la frame (décalage de la zone de défilement)
+    inline int16_t getScrollRow(int16_t y){
+        uint16_t Row = y - m_ScrollTop;
+        if(Row < m_ScrollHeight){
+            Row += m_ScrollOffset;
+            if(Row >= m_ScrollHeight) Row -= m_ScrollHeight;
+            return m_ScrollTop + Row;
+        }
+        return y;
+    }
+
+    // Test si les lignes y0 à y1 - 1 sont consécutives en mémoire
+    // (faux si elles traversent le bord de l'anneau de défilement)
+    inline bool isRowsContiguous(int16_t y0, int16_t y1){
+        return (getScrollRow(y1 - 1) - getScrollRow(y0)) == (y1 - 1 - y0);
+    }
+
+    // Attente de l'accélérateur avant un accès aux pixels
+    inline void syncAccel(){
+        if(m_AccelBusy) waitAccel();
+    }
+
+    // Marquage des blocs des colonnes BlocX0 à BlocX1 et des lignes mémoire y0 à y1 - 1
+    inline void setRowsChange(uint16_t BlocX0, uint16_t BlocX1, int16_t y0, int16_t y1){
+        m_pDrawChange->setRect(BlocX0, y0 / m_BlocHeight, BlocX1, (y1 - 1) / m_BlocHeight);
+    }
+
+    // Remise des lignes de la zone de défilement dans l'ordre de la frame et
+    // suppression de la zone
+    void resetScroll();
+
+    // Ajout dans le FIFO d'une commande seule
+    void AddCommand(uint8_t Commande, const uint8_t *pData, uint8_t Size);
+
+    // Envoi à l'écran de la zone et de la position de défilement en attente
+    void sendScroll();
+
+    // Envoi à l'écran de l'orientation en attente
+    void applyRotation();
+
+    RGB         *m_pFrame = nullptr;        // Pointe sur la destination du dessin (frame, calque, tuile ou canevas)
+    RGB         *m_pFrameBuff = nullptr;    // Pointe sur la mémoire de frame
+    cDirtyMap   *m_pDrawChange = nullptr;   // Blocs modifiés de la destination du dessin
+    cLayer      *m_pLayers[LAYER_MAX];      // Calques, du fond vers le premier plan
+    uint8_t     m_NbLayers = 0;             // Nombre de calques
+    int16_t     m_OriginX = 0;              // Abscisse du premier pixel de m_pFrame
+    int16_t     m_OriginY = 0;              // Ordonnée du premier pixel de m_pFrame
+    uint16_t    m_Stride = 0;               // Ecart en pixels entre deux lignes de m_pFrame
+    bool        m_TileMode = false;         // Mode tuile : m_pFrame ne contient qu'un bloc
+    bool        m_TileActive = false;       // Mode tuile : un bloc est en construction
     uint16_t    m_InitWidth = 0;            // Largeur de l'écran (Rotation 0)
     uint16_t    m_InitHeight = 0;           // Hauteur de l'écran (Rotation 0)
     uint16_t    m_Width = 0;                // Largeur de la frame
@@ -329,7 +891,47 @@ class cRBG_Frame  : protected TFT_SPI {
     uint16_t    m_InitBlocHeight = 0;       // Hauteur d'un bloc écran (Rotation 0)
     uint16_t    m_BlocWidth = 0;            // Largeur d'un bloc
     uint16_t    m_BlocHeight = 0;           // Hauteur d'un bloc
-    bool        m_BlocChange[NB_BLOC];      // Indicateurs de changment d'état des blocs
+    cDirtyMap   m_BlocChange;               // Blocs modifiés
+    Rotation    m_Rotation = Rotation::Degre_0; // Orientation de la frame
+    bool        m_RotationPending = false;  // Orientation à envoyer à l'écran avant la transmission suivante
+    bool        m_RedrawPending = false;    // Frame à renvoyer entière dès le premier dessin (quart de tour)
+
+    // Dessin hors écran : état de la destination remplacée par le canevas
+    struct sDrawState {
+        RGB         *m_pFrame;
+        cDirtyMap   *m_pDrawChange;
+        int16_t     m_OriginX;
+        int16_t     m_OriginY;
+        uint16_t    m_Stride;
+        uint16_t    m_Width;
+        uint16_t    m_Height;
+        uint16_t    m_BlocWidth;
+        uint16_t    m_BlocHeight;
+        uint16_t    m_ScrollHeight;
+        uint16_t    m_ScrollOffset;
+        bool        m_TileMode;
+    };
+    sDrawState  m_SavedState;               // Destination à rétablir
+    bool        m_CanvasActive = false;     // Un canevas est la destination du dessin
+    cDirtyMap   m_CanvasChange;             // Blocs marqués dans le canevas (ignorés)
+
+    // Accélération
+    cAccel      *m_pAccel = nullptr;        // Accélérateur des remplissages et des copies
+    bool        m_AccelBusy = false;        // Une opération de l'accélérateur peut être en cours
+
+    // Défilement vertical
+    uint16_t    m_ScrollTop = 0;            // Première ligne de la zone
+    uint16_t    m_ScrollHeight = 0;         // Nombre de lignes de la zone (0 : pas de zone)
+    uint16_t    m_ScrollOffset = 0;         // Ligne en mémoire de la première ligne de la zone - m_ScrollTop
+    bool        m_ScrollHard = false;       // Défilement réalisé par l'écran
+    bool        m_ScrollDefPending = false; // Zone à envoyer à l'écran (VSCRDEF)
+    bool        m_ScrollPosPending = false; // Position à envoyer à l'écran (VSCRSADD)
+
+    // Regroupement des blocs
+    uint8_t     m_BandHeight = (FLUSH_BAND_HEIGHT > 0) ? FLUSH_BAND_HEIGHT : 1;  // Hauteur des bandes
+    bool        m_AutoBand = (FLUSH_BAND_HEIGHT == 0);  // Choix automatique de la hauteur des bandes
+    uint32_t    m_TuneCost[FLUSH_BAND_CHOICES] = {0};   // Coûts cumulés pour 1, 2, 4 ... lignes de blocs
+    uint16_t    m_TuneFrames = 0;                   // Nombre de transmissions observées
     
     // FIFO
     FIFO_Data   *m_pFIFO = nullptr;         // Pointe sur le FIFO de transmission bloc
@@ -8,6 +8,7 @@
 //------------------------------------------------------------------------
 #include "GFX.h"
 #include "Debug.h"
+#include <string.h>
 
 //***********************************************************************************
 // CFont
@@ -41,47 +42,489 @@ cFont::cFont(const GFXfont *pFont)
         }
         pTable++;
     }
+
+    // Largeur max des chiffres (alignement des valeurs numériques)
+    m_DigitWidth = 0;
+    for (char c = '0'; c <= '9'; c++)
+    {
+        if ((c >= pFont->first) && (c <= pFont->last) && (getCharWidth(c) > m_DigitWidth))
+        {
+            m_DigitWidth = getCharWidth(c);
+        }
+    }
+}
+
+//***********************************************************************************
+// cCanvas
+// Surface de dessin hors écran
+
+//-----------------------------------------------------------------------------------
+// Initialisation
+void cCanvas::Init(RGB *pBuff, uint16_t Width, uint16_t Height){
+    m_pPixels = pBuff;
+    m_Width = Width;
+    m_Height = Height;
+    m_Image = cImage(Width, Height, TypeImage::R8G8B8A8, (const uint8_t *)pBuff);
+    Clear();
+}
+
+//-----------------------------------------------------------------------------------
+// Effacement complet du canevas
+void cCanvas::Clear(){
+    RGB *pPixel = m_pPixels;
+    for(uint32_t Index = 0; Index < ((uint32_t)m_Width * m_Height); Index++){
+        pPixel->clear();
+        pPixel++;
+    }
+}
+
+//***********************************************************************************
+// cTextLayout
+// Mise en page d'un texte
+
+//-----------------------------------------------------------------------------------
+// Mise en page du texte
+void cTextLayout::Layout(cFont *pFont, const char *Text, uint16_t MaxWidth)
+{
+    m_pFont = pFont;
+    m_pText = Text;
+    m_NbLines = 0;
+    m_Width = 0;
+    m_Height = 0;
+
+    // Table des avances, mesurée une seule fois
+    uint16_t NbChar = 0;
+    while ((Text[NbChar] != '\0') && (NbChar < TEXT_LAYOUT_MAX_CHAR))
+    {
+        m_Advance[NbChar] = (Text[NbChar] == '\n') ? 0 : pFont->getCharWidth(Text[NbChar]);
+        NbChar++;
+    }
+    m_NbChar = NbChar;
+
+    // Découpage en lignes
+    uint16_t Start = 0;
+    while ((Start < NbChar) && (m_NbLines < TEXT_LAYOUT_MAX_LINES))
+    {
+        uint16_t Index = Start;
+        uint16_t Width = 0;
+        bool     HasBreak = false;      // Un espace permet de couper la ligne
+        uint16_t BreakIndex = Start;    // Index du dernier espace
+        uint16_t BreakWidth = 0;        // Largeur de la ligne avant cet espace
+
+        while ((Index < NbChar) && (Text[Index] != '\n'))
+        {
+            if ((MaxWidth != 0) && (Index > Start) && ((Width + m_Advance[Index]) > MaxWidth))
+            {
+                break;
+            }
+            if (Text[Index] == ' ')
+            {
+                HasBreak = true;
+                BreakIndex = Index;
+                BreakWidth = Width;
+            }
+            Width += m_Advance[Index];
+            Index++;
+        }
+
+        uint16_t End = Index;
+        uint16_t Next = Index;
+        if ((Index < NbChar) && (Text[Index] == '\n'))
+        {
+            // Retour à la ligne explicite
+            Next = Index + 1;
+        }
+        else if ((Index < NbChar) && HasBreak)
+        {
+            // Ligne trop longue coupée sur le dernier espace
+            End = BreakIndex;
+            Width = BreakWidth;
+            Next = BreakIndex + 1;
+        }
+        // sinon le mot est trop long pour la ligne, il est coupé
+
+        sTextLine *pLine = &m_Lines[m_NbLines++];
+        pLine->m_Start = Start;
+        pLine->m_Length = End - Start;
+        pLine->m_Width = Width;
+        if (Width > m_Width)
+        {
+            m_Width = Width;
+        }
+        Start = Next;
+    }
+
+    if (m_NbLines != 0)
+    {
+        m_Height = ((m_NbLines - 1) * pFont->getGFXfont()->yAdvance) + pFont->getHeight();
+    }
+}
+
+//***********************************************************************************
+// Trigonométrie en virgule fixe
+
+// Table des sinus de 0 à 90 degrés en virgule fixe Q15 (32768 = 1.0)
+static const uint16_t s_SinTable[91] = {
+        0,   572,  1144,  1715,  2286,  2856,  3425,  3993,  4560,  5126,
+     5690,  6252,  6813,  7371,  7927,  8481,  9032,  9580, 10126, 10668,
+    11207, 11743, 12275, 12803, 13328, 13848, 14365, 14876, 15384, 15886,
+    16384, 16877, 17364, 17847, 18324, 18795, 19261, 19720, 20174, 20622,
+    21063, 21498, 21926, 22348, 22763, 23170, 23571, 23965, 24351, 24730,
+    25102, 25466, 25822, 26170, 26510, 26842, 27166, 27482, 27789, 28088,
+    28378, 28660, 28932, 29197, 29452, 29698, 29935, 30163, 30382, 30592,
+    30792, 30983, 31164, 31336, 31499, 31651, 31795, 31928, 32052, 32166,
+    32270, 32365, 32449, 32524, 32588, 32643, 32688, 32723, 32748, 32763,
+    32768
+};
+
+//-----------------------------------------------------------------------------------
+// Sinus d'un angle en degrés (Q15)
+static inline int32_t SinQ15(int16_t Angle){
+    Angle %= 360;
+    if(Angle < 0) Angle += 360;
+    if(Angle <= 90) return s_SinTable[Angle];
+    if(Angle <= 180) return s_SinTable[180 - Angle];
+    if(Angle <= 270) return -(int32_t)s_SinTable[Angle - 180];
+    return -(int32_t)s_SinTable[360 - Angle];
+}
+
+//-----------------------------------------------------------------------------------
+// Cosinus d'un angle en degrés (Q15)
+static inline int32_t CosQ15(int16_t Angle){
+    return SinQ15(Angle + 90);
+}
+
+//***********************************************************************************
+// cPolyEdges
+// Table des arêtes d'un remplissage de polygone par balayage
+
+//-----------------------------------------------------------------------------------
+// Arrondi par excès d'une valeur 16.16
+static inline int32_t CeilFixed(int32_t Value){
+    return (Value + 0xFFFF) >> 16;
+}
+
+//-----------------------------------------------------------------------------------
+// Ajout d'une arête
+// Une arête couvre les lignes dont le centre est compris entre y0 (inclus) et y1 (exclu)
+bool cPolyEdges::AddEdge(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+{
+    int8_t Winding = 1;
+    if (y0 > y1)
+    {
+        int32_t Temp;
+        Temp = x0; x0 = x1; x1 = Temp;
+        Temp = y0; y0 = y1; y1 = Temp;
+        Winding = -1;
+    }
+    int32_t yStart = CeilFixed(y0);
+    int32_t yEnd = CeilFixed(y1);
+    if (yStart >= yEnd)
+    {
+        // Arête horizontale ou ne couvrant aucun centre de pixel
+        return true;
+    }
+    if (m_NbEdges >= POLY_MAX_EDGES)
+    {
+        return false;
+    }
+
+    sPolyEdge *pEdge = &m_Edges[m_NbEdges++];
+    pEdge->m_dxdy = (int32_t)(((int64_t)(x1 - x0) * 65536) / (y1 - y0));
+    pEdge->m_x = x0 + (int32_t)((((int64_t)yStart * 65536 - y0) * pEdge->m_dxdy) >> 16);
+    pEdge->m_yStart = yStart;
+    pEdge->m_yEnd = yEnd;
+    pEdge->m_Winding = Winding;
+    return true;
+}
+
+//-----------------------------------------------------------------------------------
+// Ajout d'un contour fermé
+// Le contour est orienté dans le sens positif (aire signée positive) : tous les
+// contours ont le même sens et la règle non nulle remplit leur union.
+bool cPolyEdges::AddContour(const int32_t *px, const int32_t *py, uint16_t NbPoints)
+{
+    int64_t Area = 0;
+    for (uint16_t Index = 0; Index < NbPoints; Index++)
+    {
+        uint16_t Next = (Index + 1 == NbPoints) ? 0 : Index + 1;
+        Area += ((int64_t)px[Index] * py[Next]) - ((int64_t)px[Next] * py[Index]);
+    }
+    for (uint16_t Index = 0; Index < NbPoints; Index++)
+    {
+        uint16_t Next = (Index + 1 == NbPoints) ? 0 : Index + 1;
+        bool Result;
+        if (Area < 0)
+        {
+            Result = AddEdge(px[Next], py[Next], px[Index], py[Index]);
+        }
+        else
+        {
+            Result = AddEdge(px[Index], py[Index], px[Next], py[Next]);
+        }
+        if (!Result)
+        {
+            return false;
+        }
+    }
+    return true;
 }
 
 //***********************************************************************************
 // cGFX
 //   Bibliothèque Graphique
 
+//-----------------------------------------------------------------------------------
+// Calcul des plages de x d'un arc pour chacun des 8 octants du cercle de Bresenham
+//   Dans chaque octant l'angle varie de façon monotone avec x (x = radius * sin(angle local)).
+//   Les octants pairs voient l'angle croitre avec x, les octants impairs décroitre.
+//   L'arc [AlphaIn, AlphaOut] (ou [AlphaIn, 360] + [0, AlphaOut] s'il passe par 0)
+//   donne au plus deux plages par octant.
+void cGFX::getArcOctants(sArcOctants &Octants, uint16_t radius, uint16_t AlphaIn, uint16_t AlphaOut){
+    if(AlphaIn > 360) AlphaIn = 360;
+    if(AlphaOut > 360) AlphaOut = 360;
+
+    // Intervalles d'angles couverts par l'arc
+    uint16_t Lo[2];
+    uint16_t Hi[2];
+    uint8_t  NbInterval;
+    if(AlphaIn <= AlphaOut){
+        Lo[0] = AlphaIn;  Hi[0] = AlphaOut;
+        NbInterval = 1;
+    }else{
+        Lo[0] = 0;        Hi[0] = AlphaOut;
+        Lo[1] = AlphaIn;  Hi[1] = 360;
+        NbInterval = 2;
+    }
+
+    for(uint8_t Octant = 0; Octant < 8; Octant++){
+        int16_t Base = Octant * 45;
+        for(uint8_t Index = 0; Index < 2; Index++){
+            // Plage vide par défaut
+            Octants.m_Min[Octant][Index] = 1;
+            Octants.m_Max[Octant][Index] = 0;
+            if(Index >= NbInterval) continue;
+
+            // Intersection avec l'octant, en angle local 0..45
+            int16_t l = Lo[Index] - Base;
+            int16_t h = Hi[Index] - Base;
+            if(l < 0) l = 0;
+            if(h > 45) h = 45;
+            if(l > h) continue;
+
+            // Conversion en x
+            if((Octant & 1) != 0){
+                int16_t Temp = 45 - l;
+                l = 45 - h;
+                h = Temp;
+            }
+            Octants.m_Min[Octant][Index] = (l == 0) ? 0 : (int16_t)((radius * SinQ15(l) + 16384) >> 15);
+            Octants.m_Max[Octant][Index] = (h == 45) ? radius : (int16_t)((radius * SinQ15(h) + 16384) >> 15);
+        }
+    }
+}
+
+
+//-----------------------------------------------------------------------------------
+// Zone de découpage
+//-----------------------------------------------------------------------------------
+// Ajout d'une zone de découpage, intersectée avec la zone courante
+bool cGFX::pushClip(int16_t x, int16_t y, int16_t dx, int16_t dy){
+    if(m_ClipDepth >= CLIP_STACK_SIZE) return false;
+    if(dx < 0){ x += dx; dx = -dx;}
+    if(dy < 0){ y += dy; dy = -dy;}
+
+    m_ClipStack[m_ClipDepth++] = m_Clip;
+    sRect Rect = {x, y, (int16_t)(x + dx), (int16_t)(y + dy)};
+    m_Clip.Intersect(Rect);
+    return true;
+}
+
+//-----------------------------------------------------------------------------------
+// Retour à la zone de découpage précédente
+void cGFX::popClip(){
+    if(m_ClipDepth > 0){
+        m_Clip = m_ClipStack[--m_ClipDepth];
+    }
+}
+
+//-----------------------------------------------------------------------------------
+// Zone de découpage = frame complète (ou bloc en construction en mode tuile)
+void cGFX::resetClip(){
+    m_ClipDepth = 0;
+    if(m_TileMode){
+        // Mode tuile : seul le bloc en construction est accessible
+        m_Clip.m_x0 = m_OriginX;
+        m_Clip.m_y0 = m_OriginY;
+        m_Clip.m_x1 = m_TileActive ? m_OriginX + getBlocWidth() : m_OriginX;
+        m_Clip.m_y1 = m_TileActive ? m_OriginY + getBlocHeight() : m_OriginY;
+    }else{
+        m_Clip.m_x0 = 0;
+        m_Clip.m_y0 = 0;
+        m_Clip.m_x1 = cRBG_Frame::getWidth();
+        m_Clip.m_y1 = cRBG_Frame::getHeight();
+    }
+}
+
+//-----------------------------------------------------------------------------------
+// Marquage des blocs modifiés
+//-----------------------------------------------------------------------------------
+// Marquage des blocs traversés par une ligne
+void cGFX::setLineChange(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t Margin){
+    if(m_TileMode) return;
+    int32_t dx = x1 - x0;
+    int32_t dy = y1 - y0;
+    int32_t Length = (dx < 0) ? -dx : dx;
+    int32_t LengthY = (dy < 0) ? -dy : dy;
+    bool Steep = LengthY > Length;
+    if(Steep) Length = LengthY;
+    if(Length == 0){
+        setBoxChange(x0 - Margin, y0 - Margin, x0 + Margin, y0 + Margin);
+        return;
+    }
+
+    // L'interpolation entière de l'axe secondaire est exacte à un pixel près
+    int32_t Step = Steep ? getBlocHeight() : getBlocWidth();
+    int32_t Extra = Margin + 1;
+    for(int32_t Start = 0; Start < Length; Start += Step){
+        int32_t End = (Start + Step < Length) ? Start + Step : Length;
+        int32_t xs = x0 + ((dx * Start) / Length);
+        int32_t ys = y0 + ((dy * Start) / Length);
+        int32_t xe = x0 + ((dx * End) / Length);
+        int32_t ye = y0 + ((dy * End) / Length);
+        if(xs > xe){ int32_t Temp = xs; xs = xe; xe = Temp; }
+        if(ys > ye){ int32_t Temp = ys; ys = ye; ye = Temp; }
+        if(Steep){
+            setBoxChange(xs - Extra, ys, xe + Extra, ye);
+        }else{
+            setBoxChange(xs, ys - Extra, xe, ye + Extra);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------------
+// Marquage des blocs traversés par le contour d'un cercle
+// Dans le premier octant x va de 0 à R / sqrt(2) et y de R à R / sqrt(2)
+// (le pixel extérieur des cercles anti-aliasés est à R + 1)
+void cGFX::setCircleChange(int16_t centerX, int16_t centerY, uint16_t radius, const sArcOctants *pOctants){
+    int32_t R = radius + 1;
+    int32_t Diag = ((int32_t)radius * 46341) >> 16;
+    int32_t In = Diag - 2;
+    int32_t Out = Diag + 2;
+    if(In < 0) In = 0;
+    if(pOctants == nullptr){
+        setBoxChange(centerX - Out, centerY - R, centerX + Out, centerY - In);     // Haut
+        setBoxChange(centerX - Out, centerY + In, centerX + Out, centerY + R);     // Bas
+        setBoxChange(centerX - R, centerY - Out, centerX - In, centerY + Out);     // Gauche
+        setBoxChange(centerX + In, centerY - Out, centerX + R, centerY + Out);     // Droite
+        return;
+    }
+
+    // Arc : une boite par plage de x de chaque octant
+    for(uint8_t Octant = 0; Octant < 8; Octant++){
+        for(uint8_t Index = 0; Index < 2; Index++){
+            int32_t a = pOctants->m_Min[Octant][Index] - 1;
+            int32_t b = pOctants->m_Max[Octant][Index] + 1;
+            if(b > Out) b = Out;
+            if(a > b) continue;
+            switch(Octant){
+                case 0 : setBoxChange(centerX + a, centerY - R, centerX + b, centerY - In); break;
+                case 1 : setBoxChange(centerX + In, centerY - b, centerX + R, centerY - a); break;
+                case 2 : setBoxChange(centerX + In, centerY + a, centerX + R, centerY + b); break;
+                case 3 : setBoxChange(centerX + a, centerY + In, centerX + b, centerY + R); break;
+                case 4 : setBoxChange(centerX - b, centerY + In, centerX - a, centerY + R); break;
+                case 5 : setBoxChange(centerX - R, centerY + a, centerX - In, centerY + b); break;
+                case 6 : setBoxChange(centerX - R, centerY - b, centerX - In, centerY - a); break;
+                case 7 : setBoxChange(centerX - b, centerY - R, centerX - a, centerY - In); break;
+            }
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------------
 // Tracer un rectange vide 
-void cGFX::drawRect(uint16_t x, uint16_t y, int16_t dx, int16_t dy, cColor Color){
+// Contour de (x, y) à (x + dx, y + dy) inclus, chaque pixel n'est écrit qu'une fois
+void cGFX::drawRect(int16_t x, int16_t y, int16_t dx, int16_t dy, cColor Color){
     if(dx < 0){ x += dx; dx = -dx;}
     if(dy < 0){ y += dy; dy = -dy;}
 
-    drawLine(x, y, x+dx, y, Color);
-    drawLine(x+dx, y, x+dx, y+dy, Color);
-    drawLine(x+dx, y+dy, x, y+dy, Color);
-    drawLine(x, y+dy, x, y, Color);
+    fillSpan(x, x + dx, y, Color);
+    setBoxChange(x, y, x + dx, y);
+    if(dy == 0) return;
+    fillSpan(x, x + dx, y + dy, Color);
+    setBoxChange(x, y + dy, x + dx, y + dy);
+    fillVSpan(x, y + 1, y + dy - 1, Color);
+    setBoxChange(x, y + 1, x, y + dy - 1);
+    if(dx != 0){
+        fillVSpan(x + dx, y + 1, y + dy - 1, Color);
+        setBoxChange(x + dx, y + 1, x + dx, y + dy - 1);
+    }
 }
 
 //-----------------------------------------------------------------------------------
 // Tracer un rectangle plein
-void cGFX::drawFillRect(uint16_t x, uint16_t y, int16_t dx, int16_t dy, cColor Color){
+void cGFX::drawFillRect(int16_t x, int16_t y, int16_t dx, int16_t dy, cColor Color){
     if(dx < 0){ x += dx; dx = -dx;}
     if(dy < 0){ y += dy; dy = -dy;}
 
+    sRect Rect = {x, y, (int16_t)(x + dx), (int16_t)(y + dy)};
+    Rect.Intersect(m_Clip);
+    if(Rect.isEmpty()) return;
+
+    if((Color.m_A == 255) && accelFill(Rect, Color)){
+        setRectChange(Rect);
+        return;
+    }
+
     RGB *pFrame;
     RGB *pEndLigne;
+    uint16_t Width = Rect.m_x1 - Rect.m_x0;
     
-    for (uint16_t PosY = y; PosY < (y+dy); PosY++){
-        pFrame = getPtr(x, PosY);
-        pEndLigne = getPtr(x+dx, PosY);
+    for (int16_t PosY = Rect.m_y0; PosY < Rect.m_y1; PosY++){
+        pFrame = getPtr(Rect.m_x0, PosY);
+        pEndLigne = pFrame + Width;
         while (pFrame < pEndLigne){
             pFrame->set(Color);
             pFrame++;
         }
     }
+    setRectChange(Rect);
 }
+//-----------------------------------------------------------------------------------
+// Effacer un rectangle : les pixels deviennent noirs et transparents
+// Les pixels de la frame restent opaques : ils deviennent noirs
+void cGFX::eraseRect(int16_t x, int16_t y, int16_t dx, int16_t dy){
+    if(dx < 0){ x += dx; dx = -dx;}
+    if(dy < 0){ y += dy; dy = -dy;}
+    if(m_pFrame == m_pFrameBuff){
+        drawFillRect(x, y, dx, dy, cColor(0, 0, 0));
+        return;
+    }
+
+    sRect Rect = {x, y, (int16_t)(x + dx), (int16_t)(y + dy)};
+    Rect.Intersect(m_Clip);
+    if(Rect.isEmpty()) return;
+    if(accelFill(Rect, cColor(0, 0, 0, 0))){
+        setRectChange(Rect);
+        return;
+    }
+
+    uint16_t Width = Rect.m_x1 - Rect.m_x0;
+    for (int16_t PosY = Rect.m_y0; PosY < Rect.m_y1; PosY++){
+        RGB *pFrame = getPtr(Rect.m_x0, PosY);
+        RGB *pEndLigne = pFrame + Width;
+        while (pFrame < pEndLigne){
+            (pFrame++)->clear();
+        }
+    }
+    setRectChange(Rect);
+}
+
 //-----------------------------------------------------------------------------------
 // Dessin d'une ligne
 // Merci a Frédéric Goset http://fredericgoset.ovh/
 // L'algorithme de ligne de Bresenham 
-void cGFX::drawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, cColor Color)
+void cGFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, cColor Color)
 {
     int16_t dx = x1 - x0;
     int16_t dy = y1 - y0;
@@ -91,66 +534,65 @@ void cGFX::drawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, cColor C
     if(dx < 0) dx = -dx;
     if(dy < 0) dy = -dy;
 
-    RGB *pFrame;
-    RGB *pEndLigne;
- 
     if (dy == 0){
         // horizontal line
-        uint16_t Temp;
-        if(x1 < x0) {Temp = x1; x1 = x0 ; x0= Temp;}
-        pFrame = getPtr(x0,y0);
-        pEndLigne = getPtr(x1,y1);
-        while (pFrame < pEndLigne){
-            pFrame->set(Color);
-            pFrame++;
-        }
-
+        if(x1 < x0) {int16_t Temp = x1; x1 = x0 ; x0= Temp;}
+        fillSpan(x0, x1 - 1, y0, Color);
+        setBoxChange(x0, y0, x1 - 1, y0);
 
     }else if (dx == 0){
-        uint16_t Temp;
-        if(y1 < y0) {Temp = y1; y1 = y0 ; y0= Temp;}
-        pFrame = getPtr(x0,y0);
-        pEndLigne = getPtr(x1,y1);
-        while (pFrame < pEndLigne){
-            pFrame->set(Color);
-            pFrame += getWidth();
-        }
+        // vertical line
+        if(y1 < y0) {int16_t Temp = y1; y1 = y0 ; y0= Temp;}
+        fillVSpan(x0, y0, y1 - 1, Color);
+        setBoxChange(x0, y0, x0, y1 - 1);
     
-    }else if (dx >= dy) {
-        // more horizontal than vertical
-        int slope = 2 * dy;
-        int error = -dx;
-        int errorInc = -2 * dx;
-        int y = y0;
-
-        for (int x = x0; x != x1 + incX; x += incX)
-        {
-            setPixel(x,y, Color);
-            error += slope;
+    }else {
+        // Si la ligne est entièrement dans la zone de découpage aucun test par pixel
+        bool Inside = m_Clip.Contains((x0 < x1) ? x0 : x1, (y0 < y1) ? y0 : y1,
+                                      ((x0 > x1) ? x0 : x1) + 1, ((y0 > y1) ? y0 : y1) + 1);
+        if(!Inside){
+            sRect Box = {(x0 < x1) ? x0 : x1, (y0 < y1) ? y0 : y1,
+                         (int16_t)(((x0 > x1) ? x0 : x1) + 1), (int16_t)(((y0 > y1) ? y0 : y1) + 1)};
+            if(!Box.Overlaps(m_Clip)) return;
+        }
+        setLineChange(x0, y0, x1, y1, 0);
+
+        if (dx >= dy) {
+            // more horizontal than vertical
+            int slope = 2 * dy;
+            int error = -dx;
+            int errorInc = -2 * dx;
+            int y = y0;
 
-            if (error >= 0)
+            for (int x = x0; x != x1 + incX; x += incX)
             {
-                y += incY;
-                error += errorInc;
-            }
-        }
-    
-    }else{
-        // more vertical than horizontal
-        int slope = 2 * dx;
-        int error = -dy;
-        int errorInc = -2 * dy;
-        int x = x0;
+                plot(x, y, Color, Inside);
+                error += slope;
 
-        for (int y = y0; y != y1 + incY; y += incY)
-        {
-            setPixel(x,y, Color);
-            error += slope;
+                if (error >= 0)
+                {
+                    y += incY;
+                    error += errorInc;
+                }
+            }
+        
+        }else{
+            // more vertical than horizontal
+            int slope = 2 * dx;
+            int error = -dy;
+            int errorInc = -2 * dy;
+            int x = x0;
 
-            if (error >= 0)
+            for (int y = y0; y != y1 + incY; y += incY)
             {
-                x += incX;
-                error += errorInc;
+                plot(x, y, Color, Inside);
+                error += slope;
+
+                if (error >= 0)
+                {
+                    x += incX;
+                    error += errorInc;
+                }
             }
         }
     }
@@ -160,22 +602,28 @@ void cGFX::drawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, cColor C
 // Dessin d'un cercle
 // Merci a Frédéric Goset http://fredericgoset.ovh/
 // L'algorithme de cercle de Bresenham 
-void cGFX::drawCircle(uint16_t centerX, uint16_t centerY, uint16_t radius, cColor Color)
+void cGFX::drawCircle(int16_t centerX, int16_t centerY, uint16_t radius, cColor Color)
 {
+    sRect Box = {(int16_t)(centerX - radius), (int16_t)(centerY - radius),
+                 (int16_t)(centerX + radius + 1), (int16_t)(centerY + radius + 1)};
+    if(!Box.Overlaps(m_Clip)) return;
+    bool Inside = m_Clip.Contains(Box.m_x0, Box.m_y0, Box.m_x1, Box.m_y1);
+    setCircleChange(centerX, centerY, radius);
+
     int16_t x = 0;
     int16_t y = radius;
     int16_t m = 5 - 4 * radius;
 
     while (x <= y)
     {
-        setPixel(centerX + x, centerY + y, Color);
-        setPixel(centerX + x, centerY - y, Color);
-        setPixel(centerX - x, centerY + y, Color);
-        setPixel(centerX - x, centerY - y, Color);
-        setPixel(centerX + y, centerY + x, Color);
-        setPixel(centerX + y, centerY - x, Color);
-        setPixel(centerX - y, centerY + x, Color);
-        setPixel(centerX - y, centerY - x, Color);
+        plot(centerX + x, centerY + y, Color, Inside);
+        plot(centerX + x, centerY - y, Color, Inside);
+        plot(centerX - x, centerY + y, Color, Inside);
+        plot(centerX - x, centerY - y, Color, Inside);
+        plot(centerX + y, centerY + x, Color, Inside);
+        plot(centerX + y, centerY - x, Color, Inside);
+        plot(centerX - y, centerY + x, Color, Inside);
+        plot(centerX - y, centerY - x, Color, Inside);
 
         if (m > 0)
         {
@@ -189,58 +637,34 @@ void cGFX::drawCircle(uint16_t centerX, uint16_t centerY, uint16_t radius, cColo
 
 //-----------------------------------------------------------------------------------
 // Dessin d'un arc de cercle
-// L'algorithme de cercle de Bresenham 
-void cGFX::drawArc(uint16_t centerX, uint16_t centerY, uint16_t radius, uint16_t AlphaIn, uint16_t AlphaOut, cColor Color)
+// L'algorithme de cercle de Bresenham
+// Les angles sont en degrés, 0 en haut, sens horaire. Si AlphaIn > AlphaOut l'arc passe par 0.
+// Les bornes de l'arc sont converties une seule fois en plages de x pour chaque octant,
+// la boucle de tracé n'utilise ensuite que des comparaisons entières.
+void cGFX::drawArc(int16_t centerX, int16_t centerY, uint16_t radius, uint16_t AlphaIn, uint16_t AlphaOut, cColor Color)
 {
-    bool Inv = false;
-    if(AlphaIn > AlphaOut){
-        uint16_t Temp = AlphaIn;
-        AlphaIn = AlphaOut;
-        AlphaOut = Temp;
-        Inv = true;
-    }
+    sRect Box = {(int16_t)(centerX - radius), (int16_t)(centerY - radius),
+                 (int16_t)(centerX + radius + 1), (int16_t)(centerY + radius + 1)};
+    if(!Box.Overlaps(m_Clip)) return;
+    bool Inside = m_Clip.Contains(Box.m_x0, Box.m_y0, Box.m_x1, Box.m_y1);
+
+    sArcOctants Octants;
+    getArcOctants(Octants, radius, AlphaIn, AlphaOut);
+    setCircleChange(centerX, centerY, radius, &Octants);
+
     int16_t x = 0;
     int16_t y = radius;
     int16_t m = 5 - 4 * radius;
 
     while (x <= y) {
-        
-        uint16_t angle = atan2((float) y, (float) x) * 180 / __PI; // Conversion de radians en degrés
-        if(Inv){
-            uint16_t angle1 = 90 - angle;        
-            if(!((angle1 >= AlphaIn) && (angle1 <= AlphaOut)))  setPixel(centerX + x, centerY - y, Color);
-            uint16_t angle2 = angle;
-            if(!((angle2 >= AlphaIn) && (angle2 <= AlphaOut)))  setPixel(centerX + y, centerY - x, Color);
-            angle1 += 90;       
-            if(!((angle1 >= AlphaIn) && (angle1 <= AlphaOut)))  setPixel(centerX + y, centerY + x, Color);
-            angle2 += 90;
-            if(!((angle2 >= AlphaIn) && (angle2 <= AlphaOut)))  setPixel(centerX + x, centerY + y, Color);
-            angle1 += 90;
-            if(!((angle1 >= AlphaIn) && (angle1 <= AlphaOut)))  setPixel(centerX - x, centerY + y, Color);
-            angle2 += 90;
-            if(!((angle2 >= AlphaIn) && (angle2 <= AlphaOut)))  setPixel(centerX - y, centerY + x, Color);
-            angle1 += 90;
-            if(!((angle1 >= AlphaIn) && (angle1 <= AlphaOut)))  setPixel(centerX - y, centerY - x, Color);
-            angle2 += 90;
-            if(!((angle2 >= AlphaIn) && (angle2 <= AlphaOut)))  setPixel(centerX - x, centerY - y, Color);
-        }else{
-            uint16_t angle1 = 90 - angle;        
-            if(((angle1 >= AlphaIn) && (angle1 <= AlphaOut)))  setPixel(centerX + x, centerY - y, Color);
-            uint16_t angle2 = angle;
-            if(((angle2 >= AlphaIn) && (angle2 <= AlphaOut)))  setPixel(centerX + y, centerY - x, Color);
-            angle1 += 90;       
-            if(((angle1 >= AlphaIn) && (angle1 <= AlphaOut)))  setPixel(centerX + y, centerY + x, Color);
-            angle2 += 90;
-            if(((angle2 >= AlphaIn) && (angle2 <= AlphaOut)))  setPixel(centerX + x, centerY + y, Color);
-            angle1 += 90;
-            if(((angle1 >= AlphaIn) && (angle1 <= AlphaOut)))  setPixel(centerX - x, centerY + y, Color);
-            angle2 += 90;
-            if(((angle2 >= AlphaIn) && (angle2 <= AlphaOut)))  setPixel(centerX - y, centerY + x, Color);
-            angle1 += 90;
-            if(((angle1 >= AlphaIn) && (angle1 <= AlphaOut)))  setPixel(centerX - y, centerY - x, Color);
-            angle2 += 90;
-            if(((angle2 >= AlphaIn) && (angle2 <= AlphaOut)))  setPixel(centerX - x, centerY - y, Color);
-        }
+        if(inArcOctant(Octants, 0, x)) plot(centerX + x, centerY - y, Color, Inside);
+        if(inArcOctant(Octants, 1, x)) plot(centerX + y, centerY - x, Color, Inside);
+        if(inArcOctant(Octants, 2, x)) plot(centerX + y, centerY + x, Color, Inside);
+        if(inArcOctant(Octants, 3, x)) plot(centerX + x, centerY + y, Color, Inside);
+        if(inArcOctant(Octants, 4, x)) plot(centerX - x, centerY + y, Color, Inside);
+        if(inArcOctant(Octants, 5, x)) plot(centerX - y, centerY + x, Color, Inside);
+        if(inArcOctant(Octants, 6, x)) plot(centerX - y, centerY - x, Color, Inside);
+        if(inArcOctant(Octants, 7, x)) plot(centerX - x, centerY - y, Color, Inside);
 
         if (m > 0)
         {
@@ -254,91 +678,845 @@ void cGFX::drawArc(uint16_t centerX, uint16_t centerY, uint16_t radius, uint16_t
 
 //-----------------------------------------------------------------------------------
 // Dessin d'un cercle plein
-void cGFX::drawFillCircle(uint16_t centerX, uint16_t centerY, uint16_t radius, cColor Color)
+// Un pixel appartient au disque si x² + y² <= R² + R. Chaque ligne est remplie
+// une seule fois, la demi-largeur est mise à jour de façon incrémentale.
+void cGFX::drawFillCircle(int16_t centerX, int16_t centerY, uint16_t radius, cColor Color)
 {
-    int32_t  x  = 0;
-    int32_t  dx = 1;
-    int32_t  dy = radius+radius;
-    int32_t  p  = -(radius>>1);
-
-    uint16_t x1 = centerX - radius;
-    uint16_t x2 = x1 + dy+1;
-    uint16_t y1 = centerY;   
-    RGB *pFrame = getPtr(x1, y1);
-    for (int xx = x1; xx <= x2; xx++)
-        pFrame++->set(Color);
-    
-    while(x<radius){
-        if(p>=0) {
-            x1 = centerX - x;
-            x2 = x1 + dx;
-            y1 = centerY + radius;
-            pFrame = getPtr(x1, y1);
-            for (int xx = x1; xx <= x2; xx++)
-                pFrame++->set(Color);
-            y1 = centerY - radius;
-            pFrame = getPtr(x1, y1);
-            for (int xx = x1; xx <= x2; xx++)
-                pFrame++->set(Color);            
-
-            dy-=2;
-            p-=dy;
-            radius--;
-        }
-        dx+=2;
-        p+=dx;
-        x++;
-        
-        x1 = centerX - radius;
-        x2 = x1 + dy+1;
-        y1 = centerY + x;
-        pFrame = getPtr(x1, y1);
-        for (int xx = x1; xx <= x2; xx++)
-            pFrame++->set(Color);    
-    
-        y1 = centerY - x;
-        pFrame = getPtr(x1, y1);
-        for (int xx = x1; xx <= x2; xx++)
-            pFrame++->set(Color); 
-  }
+    setBoxChange(centerX - radius, centerY - radius, centerX + radius, centerY + radius);
+    int32_t Limit = (radius * radius) + radius;
+    int32_t Half = radius;
+    for(int32_t dy = 0; dy <= radius; dy++){
+        while((Half * Half) > (Limit - (dy * dy))) Half--;
+        fillSpan(centerX - Half, centerX + Half, centerY + dy, Color);
+        if(dy != 0){
+            fillSpan(centerX - Half, centerX + Half, centerY - dy, Color);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------------
+// Dessin d'une ellipse pleine
+// Un pixel appartient à l'ellipse si (x / (Rx + 0.5))² + (y / (Ry + 0.5))² <= 1
+// soit en entiers (2x)²b² + (2y)²a² <= a²b² avec a = 2Rx + 1 et b = 2Ry + 1
+void cGFX::drawFillEllipse(int16_t centerX, int16_t centerY, uint16_t radiusX, uint16_t radiusY, cColor Color)
+{
+    setBoxChange(centerX - radiusX, centerY - radiusY, centerX + radiusX, centerY + radiusY);
+    int64_t a = (2 * radiusX) + 1;
+    int64_t b = (2 * radiusY) + 1;
+    int64_t a2 = a * a;
+    int64_t b2 = b * b;
+    int64_t Limit = a2 * b2;
+    int32_t Half = radiusX;
+    for(int32_t dy = 0; dy <= radiusY; dy++){
+        int64_t LimitRow = Limit - (4 * dy * dy) * a2;
+        while((Half >= 0) && ((4 * Half * Half) * b2 > LimitRow)) Half--;
+        if(Half < 0) break;
+        fillSpan(centerX - Half, centerX + Half, centerY + dy, Color);
+        if(dy != 0){
+            fillSpan(centerX - Half, centerX + Half, centerY - dy, Color);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------------
+// Dessin d'un rectangle plein à coins arrondis
+// Les coins utilisent le même critère que drawFillCircle, chaque ligne est remplie une fois
+void cGFX::drawFillRoundRect(int16_t x, int16_t y, int16_t dx, int16_t dy, uint16_t radius, cColor Color)
+{
+    if(dx < 0){ x += dx; dx = -dx;}
+    if(dy < 0){ y += dy; dy = -dy;}
+    if(radius > (dx / 2)) radius = dx / 2;
+    if(radius > (dy / 2)) radius = dy / 2;
+    setBoxChange(x, y, x + dx - 1, y + dy - 1);
+
+    // Lignes des coins
+    int16_t xLeft = x + radius;
+    int16_t xRight = x + dx - 1 - radius;
+    int16_t yTop = y + radius;
+    int16_t yBottom = y + dy - 1 - radius;
+    int32_t Limit = (radius * radius) + radius;
+    int32_t Half = radius;
+    for(int32_t Offset = 1; Offset <= radius; Offset++){
+        while((Half * Half) > (Limit - (Offset * Offset))) Half--;
+        fillSpan(xLeft - Half, xRight + Half, yTop - Offset, Color);
+        fillSpan(xLeft - Half, xRight + Half, yBottom + Offset, Color);
+    }
+
+    // Lignes centrales
+    for(int16_t PosY = yTop; PosY <= yBottom; PosY++){
+        fillSpan(x, x + dx - 1, PosY, Color);
+    }
+}
+
+//-----------------------------------------------------------------------------------
+// Dessin d'un secteur d'anneau plein
+// Le secteur est rempli ligne par ligne : pour chaque ligne on calcule les portions
+// de l'anneau (disque extérieur moins le trou) puis leur intersection avec le secteur
+// angulaire. Chaque pixel n'est écrit qu'une seule fois.
+void cGFX::drawFillArc(int16_t centerX, int16_t centerY, uint16_t innerRadius, uint16_t outerRadius,
+                       uint16_t AlphaIn, uint16_t AlphaOut, cColor Color)
+{
+    if(innerRadius > outerRadius){
+        uint16_t Temp = innerRadius;
+        innerRadius = outerRadius;
+        outerRadius = Temp;
+    }
+    if(AlphaIn > 360) AlphaIn = 360;
+    if(AlphaOut > 360) AlphaOut = 360;
+
+    // Secteur angulaire
+    uint16_t Sweep = (AlphaIn <= AlphaOut) ? AlphaOut - AlphaIn : 360 - AlphaIn + AlphaOut;
+    if(Sweep == 0) return;
+    setBoxChange(centerX - outerRadius, centerY - outerRadius, centerX + outerRadius, centerY + outerRadius);
+    sArcSector Sector;
+    Sector.m_Full = (Sweep >= 360);
+    Sector.m_Union = (Sweep > 180);
+    Sector.m_Sx = SinQ15(AlphaIn);
+    Sector.m_Sy = -CosQ15(AlphaIn);
+    Sector.m_Ex = SinQ15(AlphaOut);
+    Sector.m_Ey = -CosQ15(AlphaOut);
+
+    // Un pixel appartient à l'anneau si r² - r <= x² + y² <= R² + R
+    // Les demi-largeurs sont mises à jour de façon incrémentale ligne après ligne
+    int32_t R = outerRadius;
+    int32_t r = innerRadius;
+    int32_t LimitOut = (R * R) + R;
+    int32_t LimitIn = (r * r) - r;
+    int32_t HalfOut = R;
+    int32_t HalfIn = r;
+    for(int32_t dy = 0; dy <= R; dy++){
+        int32_t dy2 = dy * dy;
+        while((HalfOut * HalfOut) > (LimitOut - dy2)) HalfOut--;
+        while((HalfIn >= 0) && ((HalfIn * HalfIn) >= (LimitIn - dy2))) HalfIn--;
+
+        fillArcRow(Sector, centerX, centerY + dy, dy, HalfOut, HalfIn, Color);
+        if(dy != 0){
+            fillArcRow(Sector, centerX, centerY - dy, -dy, HalfOut, HalfIn, Color);
+        }
+    }
+}
+
+// Valeur "infinie" pour les intervalles des demi-plans
+#define SPAN_INF 0x3FFFFFFF
+
+//-----------------------------------------------------------------------------------
+// Division entière arrondie par défaut (d > 0)
+static inline int32_t FloorDiv(int32_t n, int32_t d){
+    return (n >= 0) ? n / d : -((-n + d - 1) / d);
+}
+
+//-----------------------------------------------------------------------------------
+// Intervalle [Min, Max] des x entiers tels que a * x + b >= 0
+static inline void HalfPlaneSpan(int32_t a, int32_t b, int32_t &Min, int32_t &Max){
+    if(a > 0){
+        Min = -FloorDiv(b, a);
+        Max = SPAN_INF;
+    }else if(a < 0){
+        Min = -SPAN_INF;
+        Max = FloorDiv(b, -a);
+    }else if(b >= 0){
+        Min = -SPAN_INF;
+        Max = SPAN_INF;
+    }else{
+        Min = 1;
+        Max = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------------
+// Remplissage d'une ligne d'un arc plein
+//   Demi-plan de départ : cross(S, P) >= 0, demi-plan de fin : cross(P, E) >= 0
+//   (en coordonnées écran, y vers le bas, un produit vectoriel positif est horaire)
+void cGFX::fillArcRow(const sArcSector &Sector, int16_t centerX, int16_t y, int32_t dy,
+                      int32_t HalfOut, int32_t HalfIn, cColor Color){
+    // Portions de l'anneau
+    int32_t RingMin[2];
+    int32_t RingMax[2];
+    uint8_t NbRing;
+    if(HalfIn < 0){
+        RingMin[0] = -HalfOut; RingMax[0] = HalfOut;
+        NbRing = 1;
+    }else{
+        RingMin[0] = -HalfOut;   RingMax[0] = -HalfIn - 1;
+        RingMin[1] = HalfIn + 1; RingMax[1] = HalfOut;
+        NbRing = 2;
+    }
+
+    // Portions du secteur angulaire
+    int32_t SecMin[2];
+    int32_t SecMax[2];
+    uint8_t NbSec = 1;
+    if(Sector.m_Full){
+        SecMin[0] = -SPAN_INF; SecMax[0] = SPAN_INF;
+    }else{
+        HalfPlaneSpan(-Sector.m_Sy, Sector.m_Sx * dy, SecMin[0], SecMax[0]);
+        HalfPlaneSpan(Sector.m_Ey, -Sector.m_Ex * dy, SecMin[1], SecMax[1]);
+        if(!Sector.m_Union){
+            // Intersection
+            if(SecMin[1] > SecMin[0]) SecMin[0] = SecMin[1];
+            if(SecMax[1] < SecMax[0]) SecMax[0] = SecMax[1];
+        }else if(SecMin[1] > SecMax[1]){
+            // Union, second intervalle vide
+        }else if(SecMin[0] > SecMax[0]){
+            // Union, premier intervalle vide
+            SecMin[0] = SecMin[1]; SecMax[0] = SecMax[1];
+        }else if((SecMin[1] <= SecMax[0] + 1) && (SecMin[0] <= SecMax[1] + 1)){
+            // Union d'intervalles qui se recouvrent
+            if(SecMin[1] < SecMin[0]) SecMin[0] = SecMin[1];
+            if(SecMax[1] > SecMax[0]) SecMax[0] = SecMax[1];
+        }else{
+            // Union d'intervalles disjoints
+            NbSec = 2;
+        }
+    }
+
+    // Intersection anneau / secteur
+    for(uint8_t Ring = 0; Ring < NbRing; Ring++){
+        for(uint8_t Sec = 0; Sec < NbSec; Sec++){
+            int32_t Min = (RingMin[Ring] > SecMin[Sec]) ? RingMin[Ring] : SecMin[Sec];
+            int32_t Max = (RingMax[Ring] < SecMax[Sec]) ? RingMax[Ring] : SecMax[Sec];
+            if(Min <= Max){
+                fillSpan(centerX + Min, centerX + Max, y, Color);
+            }
+        }
+    }
+}
+
+// ==========================================================================
+// Dessiner des polygones et des polylignes
+
+// Nombre de sommets d'un disque polygonal (jointures et extrémités arrondies)
+#define POLY_DISC_POINTS 12
+
+//-----------------------------------------------------------------------------------
+// Conversion en virgule fixe 16.16
+static inline int32_t ToFixed(float Value){
+    return (int32_t)(Value * 65536.0f);
+}
+
+//-----------------------------------------------------------------------------------
+// Tracer un polygone plein
+bool cGFX::drawFillPolygon(const sPoint *pPoints, uint16_t NbPoints, cColor Color){
+    if(NbPoints < 3) return true;
+    m_PolyEdges.Reset();
+    for(uint16_t Index = 0; Index < NbPoints; Index++){
+        uint16_t Next = (Index + 1 == NbPoints) ? 0 : Index + 1;
+        if(!m_PolyEdges.AddEdge(pPoints[Index].x * 65536, pPoints[Index].y * 65536,
+                                pPoints[Next].x * 65536, pPoints[Next].y * 65536)){
+            return false;
+        }
+    }
+    fillPolyEdges(m_PolyEdges, Color);
+    return true;
+}
+
+//-----------------------------------------------------------------------------------
+// Tracer une polyligne d'épaisseur Width
+// Chaque segment est un quadrilatère, chaque jointure un petit polygone. Tous les
+// contours sont remplis ensemble (union) : les recouvrements ne sont écrits qu'une fois.
+// Quand la table est pleine, elle est vidée au milieu d'un segment, à plus d'une
+// demi-épaisseur des jointures : les morceaux successifs ne se recouvrent pas.
+bool cGFX::drawPolyline(const sPoint *pPoints, uint16_t NbPoints, uint8_t Width, cColor Color, LineJoin Join){
+    if(NbPoints < 2) return true;
+    if(Width <= 1){
+        for(uint16_t Index = 0; Index < (NbPoints - 1); Index++){
+            drawLine(pPoints[Index].x, pPoints[Index].y, pPoints[Index+1].x, pPoints[Index+1].y, Color);
+        }
+        return true;
+    }
+    // Place nécessaire pour un segment, sa jointure et une extrémité arrondie
+    const uint16_t EdgesBySegment = 4 + (2 * POLY_DISC_POINTS);
+    if(POLY_MAX_EDGES < EdgesBySegment) return false;
+
+    float HalfWidth = Width * 0.5f;
+    float nxPrev = 0.0f;
+    float nyPrev = 0.0f;
+    bool  HasPrev = false;
+    m_PolyEdges.Reset();
+    for(uint16_t Index = 0; Index < (NbPoints - 1); Index++){
+        float x0 = pPoints[Index].x;
+        float y0 = pPoints[Index].y;
+        float x1 = pPoints[Index+1].x;
+        float y1 = pPoints[Index+1].y;
+        float Length = sqrtf(((x1 - x0) * (x1 - x0)) + ((y1 - y0) * (y1 - y0)));
+        if(Length == 0.0f) continue;
+
+        // Normale de longueur demi-épaisseur
+        float nx = -(y1 - y0) * HalfWidth / Length;
+        float ny = (x1 - x0) * HalfWidth / Length;
+
+        // La table est vidée par morceaux pour les polylignes longues
+        // Coupure au milieu du segment s'il est assez long, sinon sur le sommet
+        uint16_t Free = m_PolyEdges.getFree();
+        bool Split = (Free < (2 * EdgesBySegment)) && (Free >= (POLY_DISC_POINTS + 4)) &&
+                     (Length >= (Width + 2));
+        if(!Split && (Free < EdgesBySegment)){
+            fillPolyEdges(m_PolyEdges, Color);
+            m_PolyEdges.Reset();
+        }
+
+        // Jointure avec le segment précédent ou extrémité de départ
+        if(HasPrev){
+            addPolyJoin(x0, y0, nxPrev, nyPrev, nx, ny, HalfWidth, Join);
+        }else if(Join == LineJoin::Round){
+            addPolyDisc(x0, y0, HalfWidth);
+        }
+
+        // Segment, en deux moitiés de part et d'autre de la coupure
+        if(Split){
+            float xm = (x0 + x1) * 0.5f;
+            float ym = (y0 + y1) * 0.5f;
+            addPolySegment(x0, y0, xm, ym, nx, ny);
+            fillPolyEdges(m_PolyEdges, Color);
+            m_PolyEdges.Reset();
+            addPolySegment(xm, ym, x1, y1, nx, ny);
+        }else{
+            addPolySegment(x0, y0, x1, y1, nx, ny);
+        }
+
+        // Extrémité d'arrivée
+        if((Index == (NbPoints - 2)) && (Join == LineJoin::Round)){
+            addPolyDisc(x1, y1, HalfWidth);
+        }
+
+        nxPrev = nx;
+        nyPrev = ny;
+        HasPrev = true;
+    }
+    fillPolyEdges(m_PolyEdges, Color);
+    return true;
+}
+
+//-----------------------------------------------------------------------------------
+// Ajout de la jointure d'une polyligne
+// La jointure est placée du côté extérieur du virage, le côté intérieur est déjà
+// couvert par les deux segments.
+void cGFX::addPolyJoin(float x, float y, float nx1, float ny1, float nx2, float ny2, float HalfWidth, LineJoin Join){
+    if(Join == LineJoin::Round){
+        addPolyDisc(x, y, HalfWidth);
+        return;
+    }
+
+    // Sens du virage (les normales tournent comme les segments)
+    float Cross = (nx1 * ny2) - (ny1 * nx2);
+    if(Cross == 0.0f) return;
+    float Side = (Cross > 0.0f) ? -1.0f : 1.0f;
+    float ax = x + (Side * nx1);
+    float ay = y + (Side * ny1);
+    float bx = x + (Side * nx2);
+    float by = y + (Side * ny2);
+
+    if(Join == LineJoin::Miter){
+        // Pointe en x + (n1 + n2) / (1 + cos(angle)), coupée au delà de 4 demi-épaisseurs
+        float Dot = ((nx1 * nx2) + (ny1 * ny2)) / (HalfWidth * HalfWidth);
+        if(Dot > -0.875f){
+            float k = Side / (1.0f + Dot);
+            int32_t px[4] = {ToFixed(x), ToFixed(ax), ToFixed(x + ((nx1 + nx2) * k)), ToFixed(bx)};
+            int32_t py[4] = {ToFixed(y), ToFixed(ay), ToFixed(y + ((ny1 + ny2) * k)), ToFixed(by)};
+            m_PolyEdges.AddContour(px, py, 4);
+            return;
+        }
+    }
+
+    // Coin coupé
+    int32_t px[3] = {ToFixed(x), ToFixed(ax), ToFixed(bx)};
+    int32_t py[3] = {ToFixed(y), ToFixed(ay), ToFixed(by)};
+    m_PolyEdges.AddContour(px, py, 3);
+}
+
+//-----------------------------------------------------------------------------------
+// Ajout du quadrilatère d'un segment de polyligne
+void cGFX::addPolySegment(float x0, float y0, float x1, float y1, float nx, float ny){
+    int32_t px[4] = {ToFixed(x0 + nx), ToFixed(x1 + nx), ToFixed(x1 - nx), ToFixed(x0 - nx)};
+    int32_t py[4] = {ToFixed(y0 + ny), ToFixed(y1 + ny), ToFixed(y1 - ny), ToFixed(y0 - ny)};
+    m_PolyEdges.AddContour(px, py, 4);
+}
+
+//-----------------------------------------------------------------------------------
+// Ajout d'un disque polygonal
+void cGFX::addPolyDisc(float x, float y, float Radius){
+    int32_t px[POLY_DISC_POINTS];
+    int32_t py[POLY_DISC_POINTS];
+    for(uint8_t Index = 0; Index < POLY_DISC_POINTS; Index++){
+        int16_t Angle = (Index * 360) / POLY_DISC_POINTS;
+        px[Index] = ToFixed(x + ((Radius * SinQ15(Angle)) / 32768.0f));
+        py[Index] = ToFixed(y - ((Radius * CosQ15(Angle)) / 32768.0f));
+    }
+    m_PolyEdges.AddContour(px, py, POLY_DISC_POINTS);
+}
+
+//-----------------------------------------------------------------------------------
+// Remplissage des contours de la table des arêtes
+// Les arêtes sont triées par première ligne. Pour chaque ligne, la liste des arêtes
+// actives est mise à jour et triée par abscisse, puis les portions où l'enroulement
+// est non nul sont remplies.
+void cGFX::fillPolyEdges(cPolyEdges &Edges, cColor Color){
+    uint16_t NbEdges = Edges.m_NbEdges;
+    if(NbEdges == 0) return;
+
+    // Tri par insertion des arêtes par première ligne
+    int16_t yMax = INT16_MIN;
+    for(uint16_t Index = 0; Index < NbEdges; Index++){
+        int16_t yStart = Edges.m_Edges[Index].m_yStart;
+        uint16_t Pos = Index;
+        while((Pos > 0) && (Edges.m_Edges[Edges.m_Sorted[Pos - 1]].m_yStart > yStart)){
+            Edges.m_Sorted[Pos] = Edges.m_Sorted[Pos - 1];
+            Pos--;
+        }
+        Edges.m_Sorted[Pos] = Index;
+        if(Edges.m_Edges[Index].m_yEnd > yMax){
+            yMax = Edges.m_Edges[Index].m_yEnd;
+        }
+    }
+    if(yMax > m_Clip.m_y1) yMax = m_Clip.m_y1;
+    int16_t y = Edges.m_Edges[Edges.m_Sorted[0]].m_yStart;
+    if(y < m_Clip.m_y0) y = m_Clip.m_y0;
+
+    // Boite englobante des portions remplies
+    int32_t xMinFill = INT32_MAX;
+    int32_t xMaxFill = INT32_MIN;
+    int16_t yMinFill = INT16_MAX;
+    int16_t yMaxFill = INT16_MIN;
+
+    uint16_t NextEdge = 0;
+    uint16_t NbActive = 0;
+    for(; y < yMax; y++){
+        // Activation des arêtes qui commencent sur cette ligne
+        while((NextEdge < NbEdges) && (Edges.m_Edges[Edges.m_Sorted[NextEdge]].m_yStart <= y)){
+            uint16_t Index = Edges.m_Sorted[NextEdge++];
+            sPolyEdge *pEdge = &Edges.m_Edges[Index];
+            if(pEdge->m_yEnd <= y) continue;
+            pEdge->m_x += (int32_t)((int64_t)(y - pEdge->m_yStart) * pEdge->m_dxdy);
+            Edges.m_Active[NbActive++] = Index;
+        }
+
+        // Suppression des arêtes terminées et tri par insertion sur l'abscisse
+        // (la liste reste presque triée d'une ligne à l'autre)
+        uint16_t NbKept = 0;
+        for(uint16_t Pos = 0; Pos < NbActive; Pos++){
+            uint16_t Index = Edges.m_Active[Pos];
+            if(Edges.m_Edges[Index].m_yEnd <= y) continue;
+            int32_t x = Edges.m_Edges[Index].m_x;
+            uint16_t Insert = NbKept++;
+            while((Insert > 0) && (Edges.m_Edges[Edges.m_Active[Insert - 1]].m_x > x)){
+                Edges.m_Active[Insert] = Edges.m_Active[Insert - 1];
+                Insert--;
+            }
+            Edges.m_Active[Insert] = Index;
+        }
+        NbActive = NbKept;
+
+        // Remplissage des portions d'enroulement non nul
+        int16_t Winding = 0;
+        int32_t xStart = 0;
+        for(uint16_t Pos = 0; Pos < NbActive; Pos++){
+            sPolyEdge *pEdge = &Edges.m_Edges[Edges.m_Active[Pos]];
+            if(Winding == 0){
+                xStart = pEdge->m_x;
+            }
+            Winding += pEdge->m_Winding;
+            if(Winding == 0){
+                int32_t x0 = CeilFixed(xStart);
+                int32_t x1 = CeilFixed(pEdge->m_x) - 1;
+                if(x0 <= x1){
+                    fillSpan(x0, x1, y, Color);
+                    if(x0 < xMinFill) xMinFill = x0;
+                    if(x1 > xMaxFill) xMaxFill = x1;
+                    if(y < yMinFill) yMinFill = y;
+                    yMaxFill = y;
+                }
+            }
+            pEdge->m_x += pEdge->m_dxdy;
+        }
+    }
+    setBoxChange(xMinFill, yMinFill, xMaxFill, yMaxFill);
+}
+
+// ==========================================================================
+// Dessiner des formes anti-aliasées
+
+//-----------------------------------------------------------------------------------
+// Racine carrée entière
+static inline uint32_t ISqrt(uint64_t Value){
+    uint64_t Result = 0;
+    uint64_t Bit = (uint64_t)1 << 62;
+    while(Bit > Value) Bit >>= 2;
+    while(Bit != 0){
+        if(Value >= Result + Bit){
+            Value -= Result + Bit;
+            Result = (Result >> 1) + Bit;
+        }else{
+            Result >>= 1;
+        }
+        Bit >>= 2;
+    }
+    return (uint32_t) Result;
+}
+
+//-----------------------------------------------------------------------------------
+// Préparation du mélange
+// Sur un fond uni opaque les 17 niveaux de couverture sont précalculés,
+// le tracé n'a plus qu'à recopier une couleur opaque.
+void cGFX::initAABlend(sAABlend &Blend, cColor Color, const cColor *pBackColor){
+    Blend.m_Color = Color;
+    Blend.m_LUT = (pBackColor != nullptr);
+    if(!Blend.m_LUT) return;
+    for(uint8_t Level = 0; Level <= 16; Level++){
+        uint16_t Alpha = (Color.m_A * Level) >> 4;
+        uint16_t invAlpha = 255 - Alpha;
+        Blend.m_Table[Level].m_R = ((Alpha * Color.m_R) + (invAlpha * pBackColor->m_R)) / 255;
+        Blend.m_Table[Level].m_G = ((Alpha * Color.m_G) + (invAlpha * pBackColor->m_G)) / 255;
+        Blend.m_Table[Level].m_B = ((Alpha * Color.m_B) + (invAlpha * pBackColor->m_B)) / 255;
+    }
+}
+
+//-----------------------------------------------------------------------------------
+// Tracer une ligne anti-aliasée
+void cGFX::drawAALine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, cColor Color){
+    sAABlend Blend;
+    initAABlend(Blend, Color, nullptr);
+    drawAALine(x0, y0, x1, y1, Blend);
+}
+void cGFX::drawAALine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, cColor Color, cColor BackColor){
+    sAABlend Blend;
+    initAABlend(Blend, Color, &BackColor);
+    drawAALine(x0, y0, x1, y1, Blend);
+}
+
+//-----------------------------------------------------------------------------------
+// Ligne de Wu
+// Pour chaque pas sur l'axe principal, la position exacte sur l'axe secondaire est
+// suivie en virgule fixe 16.16 ; les deux pixels encadrants reçoivent une couverture
+// proportionnelle à leur distance à la ligne.
+void cGFX::drawAALine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, const sAABlend &Blend){
+    int16_t dx = x1 - x0;
+    int16_t dy = y1 - y0;
+    bool Steep = ((dy < 0) ? -dy : dy) > ((dx < 0) ? -dx : dx);
+    int16_t Temp;
+    if(Steep){
+        Temp = x0; x0 = y0; y0 = Temp;
+        Temp = x1; x1 = y1; y1 = Temp;
+    }
+    if(x0 > x1){
+        Temp = x0; x0 = x1; x1 = Temp;
+        Temp = y0; y0 = y1; y1 = Temp;
+    }
+    dx = x1 - x0;
+    dy = y1 - y0;
+    if(Steep){
+        setLineChange(y0, x0, y1, x1, 1);
+    }else{
+        setLineChange(x0, y0, x1, y1, 1);
+    }
+    if(dx == 0){
+        plotAA(x0, y0, 255, Blend);
+        return;
+    }
+
+    int32_t Gradient = ((int32_t)dy * 65536) / dx;
+    int32_t yFixed = (int32_t)y0 * 65536;
+    for(int16_t x = x0; x <= x1; x++){
+        int16_t y = yFixed >> 16;
+        uint8_t Frac = (yFixed >> 8) & 0xFF;
+        if(Steep){
+            plotAA(y, x, 255 - Frac, Blend);
+            plotAA(y + 1, x, Frac, Blend);
+        }else{
+            plotAA(x, y, 255 - Frac, Blend);
+            plotAA(x, y + 1, Frac, Blend);
+        }
+        yFixed += Gradient;
+    }
+}
+
+//-----------------------------------------------------------------------------------
+// Tracer un cercle anti-aliasé
+void cGFX::drawAACircle(int16_t centerX, int16_t centerY, uint16_t radius, cColor Color){
+    sAABlend Blend;
+    initAABlend(Blend, Color, nullptr);
+    drawAACircle(centerX, centerY, radius, nullptr, Blend);
+}
+void cGFX::drawAACircle(int16_t centerX, int16_t centerY, uint16_t radius, cColor Color, cColor BackColor){
+    sAABlend Blend;
+    initAABlend(Blend, Color, &BackColor);
+    drawAACircle(centerX, centerY, radius, nullptr, Blend);
+}
+
+//-----------------------------------------------------------------------------------
+// Tracer un arc de cercle anti-aliasé
+void cGFX::drawAAArc(int16_t centerX, int16_t centerY, uint16_t radius, uint16_t AlphaIn, uint16_t AlphaOut, cColor Color){
+    sArcOctants Octants;
+    getArcOctants(Octants, radius, AlphaIn, AlphaOut);
+    sAABlend Blend;
+    initAABlend(Blend, Color, nullptr);
+    drawAACircle(centerX, centerY, radius, &Octants, Blend);
+}
+void cGFX::drawAAArc(int16_t centerX, int16_t centerY, uint16_t radius, uint16_t AlphaIn, uint16_t AlphaOut, cColor Color, cColor BackColor){
+    sArcOctants Octants;
+    getArcOctants(Octants, radius, AlphaIn, AlphaOut);
+    sAABlend Blend;
+    initAABlend(Blend, Color, &BackColor);
+    drawAACircle(centerX, centerY, radius, &Octants, Blend);
+}
+
+//-----------------------------------------------------------------------------------
+// Cercle de Wu, limité aux plages de pOctants (nullptr -> cercle complet)
+// Pour chaque x du premier octant, y = sqrt(R² - x²) est calculé en virgule fixe 24.8.
+// Les points communs à deux octants (x = 0 et x = y) ne sont écrits qu'une fois.
+void cGFX::drawAACircle(int16_t centerX, int16_t centerY, uint16_t radius, const sArcOctants *pOctants, const sAABlend &Blend){
+    setCircleChange(centerX, centerY, radius, pOctants);
+    if(radius == 0){
+        plotAA(centerX, centerY, 255, Blend);
+        return;
+    }
+    int32_t R2 = (int32_t)radius * radius;
+    for(int32_t x = 0; ; x++){
+        uint32_t yFixed = ISqrt((uint64_t)(R2 - (x * x)) << 16);
+        int16_t  y = yFixed >> 8;
+        uint8_t  Frac = yFixed & 0xFF;
+        if(x > y) break;
+
+        // Octants concernés
+        uint8_t Mask = 0xFF;
+        if(pOctants != nullptr){
+            Mask = 0;
+            for(uint8_t Octant = 0; Octant < 8; Octant++){
+                if(inArcOctant(*pOctants, Octant, x)) Mask |= 1 << Octant;
+            }
+        }
+
+        // Pixel intérieur (x, y) et pixel extérieur (x, y + 1)
+        for(uint8_t Pixel = 0; Pixel < 2; Pixel++){
+            int16_t  yPixel = y + Pixel;
+            uint8_t  Coverage = (Pixel == 0) ? 255 - Frac : Frac;
+            uint8_t  PixelMask = Mask;
+            // Suppression des doublons : octants 0-7, 1-2, 3-4, 5-6 pour x = 0
+            // et octants 0-1, 2-3, 4-5, 6-7 pour x = y
+            if(x == 0){
+                PixelMask |= ((PixelMask >> 7) & 0x01) | ((PixelMask >> 1) & 0x02) | ((PixelMask >> 1) & 0x08) | ((PixelMask >> 1) & 0x20);
+                PixelMask &= 0x2B;
+            }else if(x == yPixel){
+                PixelMask |= ((PixelMask >> 1) & 0x55);
+                PixelMask &= 0x55;
+            }
+            if(PixelMask & 0x01) plotAA(centerX + x,      centerY - yPixel, Coverage, Blend);
+            if(PixelMask & 0x02) plotAA(centerX + yPixel, centerY - x,      Coverage, Blend);
+            if(PixelMask & 0x04) plotAA(centerX + yPixel, centerY + x,      Coverage, Blend);
+            if(PixelMask & 0x08) plotAA(centerX + x,      centerY + yPixel, Coverage, Blend);
+            if(PixelMask & 0x10) plotAA(centerX - x,      centerY + yPixel, Coverage, Blend);
+            if(PixelMask & 0x20) plotAA(centerX - yPixel, centerY + x,      Coverage, Blend);
+            if(PixelMask & 0x40) plotAA(centerX - yPixel, centerY - x,      Coverage, Blend);
+            if(PixelMask & 0x80) plotAA(centerX - x,      centerY - yPixel, Coverage, Blend);
+        }
+    }
 }
 
 //-----------------------------------------------------------------------------------
 // Tracer une image 8bits par couleurs (depreciated)
-void cGFX::drawR8G8B8Image(uint16_t x, uint16_t y, uint16_t dx, uint16_t dy, const uint8_t *pImg){
+void cGFX::drawR8G8B8Image(int16_t x, int16_t y, uint16_t dx, uint16_t dy, const uint8_t *pImg){
+    sRect Rect = {x, y, (int16_t)(x + dx), (int16_t)(y + dy)};
+    Rect.Intersect(m_Clip);
+    if(Rect.isEmpty()) return;
+    cImage Image(dx, dy, TypeImage::B8G8R8, pImg);
+    if(accelImage(Rect, Image, x, y)){
+        setRectChange(Rect);
+        return;
+    }
+
     RGB *pFrame;
     RGB *pEndLigne;
     const uint8_t *pImgLine;
+    uint16_t Width = Rect.m_x1 - Rect.m_x0;
 
-    for (uint16_t PosY = y; PosY < (y+dy); PosY++){
-        pFrame = getPtr(x, PosY);
-        pEndLigne = getPtr(x+dx, PosY);
-        pImgLine = pImg+(dx*(PosY-y)*3); 
+    for (int16_t PosY = Rect.m_y0; PosY < Rect.m_y1; PosY++){
+        pFrame = getPtr(Rect.m_x0, PosY);
+        pEndLigne = pFrame + Width;
+        pImgLine = pImg+((dx*(PosY-y) + (Rect.m_x0-x))*3); 
         while (pFrame < pEndLigne){
             pFrame->set(cColor((*(pImgLine+2)),(*(pImgLine+1)),(*(pImgLine))));
             pImgLine = pImgLine+3;
             pFrame++;
         }
     }
+    setRectChange(Rect);
 }
 //-----------------------------------------------------------------------------------
 // Tracer une image
-void cGFX::drawImage(uint16_t x, uint16_t y, cImage &Image){
+void cGFX::drawImage(int16_t x, int16_t y, cImage &Image){
+    sRect Rect = {x, y, (int16_t)(x + Image.getWith()), (int16_t)(y + Image.getHeight())};
+    Rect.Intersect(m_Clip);
+    if(Rect.isEmpty()) return;
+    if(accelImage(Rect, Image, x, y)){
+        setRectChange(Rect);
+        return;
+    }
+
     RGB *pFrame;
     RGB *pEndLigne;
     const uint8_t *pImgLine;
+    uint16_t Width = Rect.m_x1 - Rect.m_x0;
+    uint8_t PixelSize = Image.getPixelSize();
 
-    for (uint16_t PosY = y; PosY < (y+Image.getHeight()); PosY++){
-        pFrame = getPtr(x, PosY);
-        pEndLigne = getPtr(x+Image.getWith(), PosY);
-        pImgLine = Image.GetPtrLine(PosY-y); 
+    for (int16_t PosY = Rect.m_y0; PosY < Rect.m_y1; PosY++){
+        pFrame = getPtr(Rect.m_x0, PosY);
+        pEndLigne = pFrame + Width;
+        pImgLine = Image.GetPtrLine(PosY-y) + ((Rect.m_x0-x)*PixelSize); 
         while (pFrame < pEndLigne){
             pFrame->set(Image.getColor(pImgLine));
-            pImgLine = pImgLine + Image.getPixelSize();
+            pImgLine = pImgLine + PixelSize;
             pFrame++;
         }
     }
+    setRectChange(Rect);
 }
+// ==========================================================================
+// Sauvegarde / restauration de zones
+
+//-----------------------------------------------------------------------------------
+// Copie d'une zone de la frame dans pBuff
+void cGFX::saveRect(const sRect &Rect, RGB *pBuff, uint16_t Stride){
+    sRect Area = Rect;
+    sRect Frame = {0, 0, (int16_t)getWidth(), (int16_t)getHeight()};
+    Area.Intersect(Frame);
+    if(Area.isEmpty() || m_TileMode) return;
+
+    uint16_t Width = Area.m_x1 - Area.m_x0;
+    pBuff += (Area.m_x0 - Rect.m_x0) + ((Area.m_y0 - Rect.m_y0) * Stride);
+    if(isAccelArea(Area) &&
+       accelCopy(pBuff, Stride, getPtr(Area.m_x0, Area.m_y0), getStride(), Width, Area.m_y1 - Area.m_y0)) return;
+
+    for(int16_t PosY = Area.m_y0; PosY < Area.m_y1; PosY++){
+        RGB *pFrame = getPtr(Area.m_x0, PosY);
+        for(uint16_t Index = 0; Index < Width; Index++){
+            pBuff[Index].copy(pFrame[Index]);
+        }
+        pBuff += Stride;
+    }
+}
+
+//-----------------------------------------------------------------------------------
+// Copie de pBuff dans une zone de la frame
+void cGFX::restoreRect(const sRect &Rect, const RGB *pBuff, uint16_t Stride){
+    sRect Area = Rect;
+    sRect Frame = {0, 0, (int16_t)getWidth(), (int16_t)getHeight()};
+    Area.Intersect(Frame);
+    if(Area.isEmpty() || m_TileMode) return;
+
+    uint16_t Width = Area.m_x1 - Area.m_x0;
+    pBuff += (Area.m_x0 - Rect.m_x0) + ((Area.m_y0 - Rect.m_y0) * Stride);
+    if(isAccelArea(Area) &&
+       accelCopy(getPtr(Area.m_x0, Area.m_y0), getStride(), pBuff, Stride, Width, Area.m_y1 - Area.m_y0)){
+        setRectChange(Area);
+        return;
+    }
+
+    for(int16_t PosY = Area.m_y0; PosY < Area.m_y1; PosY++){
+        RGB *pFrame = getPtr(Area.m_x0, PosY);
+        for(uint16_t Index = 0; Index < Width; Index++){
+            pFrame[Index].copy(pBuff[Index]);
+        }
+        pBuff += Stride;
+    }
+    setRectChange(Area);
+}
+
+// ==========================================================================
+// Dessin hors écran
+
+//-----------------------------------------------------------------------------------
+// Sélection du canevas qui reçoit les primitives
+void cGFX::setCanvas(cCanvas *pCanvas){
+    if(pCanvas != nullptr){
+        setDrawCanvas(pCanvas->m_pPixels, pCanvas->m_Width, pCanvas->m_Height);
+    }else{
+        setDrawCanvas(nullptr, 0, 0);
+    }
+    resetClip();
+}
+
+//-----------------------------------------------------------------------------------
+// Copie d'un canevas en (x, y)
+// Les pixels opaques sont copiés, les autres composés (opération "over").
+void cGFX::drawCanvas(int16_t x, int16_t y, cCanvas &Canvas){
+    if(Canvas.m_pPixels == m_pFrame) return;
+    sRect Rect = {x, y, (int16_t)(x + Canvas.m_Width), (int16_t)(y + Canvas.m_Height)};
+    Rect.Intersect(m_Clip);
+    if(Rect.isEmpty()) return;
+
+    uint16_t Width = Rect.m_x1 - Rect.m_x0;
+    const RGB *pSrc = &Canvas.m_pPixels[(Rect.m_x0 - x) + ((Rect.m_y0 - y) * Canvas.m_Width)];
+    for(int16_t PosY = Rect.m_y0; PosY < Rect.m_y1; PosY++){
+        RGB *pFrame = getPtr(Rect.m_x0, PosY);
+        for(uint16_t Index = 0; Index < Width; Index++){
+            pFrame[Index].over(pSrc[Index]);
+        }
+        pSrc += Canvas.m_Width;
+    }
+    setRectChange(Rect);
+}
+
+// ==========================================================================
+// Copie de zones
+
+//-----------------------------------------------------------------------------------
+// Copie de la zone Src en (x, y)
+// Les lignes sont copiées par memmove, du bas vers le haut lorsque la destination
+// est plus basse que la source, pour que les zones puissent se recouvrir.
+void cGFX::copyRect(const sRect &Src, int16_t x, int16_t y){
+    if(m_TileMode) return;
+    sRect Area = Src;
+    sRect Frame = {0, 0, (int16_t)getWidth(), (int16_t)getHeight()};
+    Area.Intersect(Frame);
+    if(Area.isEmpty()) return;
+
+    // Destination limitée à la zone de découpage
+    int16_t dx = x - Src.m_x0;
+    int16_t dy = y - Src.m_y0;
+    sRect Dest = {(int16_t)(Area.m_x0 + dx), (int16_t)(Area.m_y0 + dy),
+                  (int16_t)(Area.m_x1 + dx), (int16_t)(Area.m_y1 + dy)};
+    Dest.Intersect(m_Clip);
+    if(Dest.isEmpty() || ((dx == 0) && (dy == 0))) return;
+
+    // Zones disjointes : copie par l'accélérateur
+    int16_t SrcX = Dest.m_x0 - dx;
+    uint16_t Width = Dest.m_x1 - Dest.m_x0;
+    sRect Source = {SrcX, (int16_t)(Dest.m_y0 - dy), (int16_t)(SrcX + Width), (int16_t)(Dest.m_y1 - dy)};
+    if(!Source.Overlaps(Dest) && isAccelArea(Dest) && isRowsContiguous(Source.m_y0, Source.m_y1) &&
+       accelCopy(getPtr(Dest.m_x0, Dest.m_y0), getStride(), getPtr(SrcX, Source.m_y0), getStride(),
+                 Width, Dest.m_y1 - Dest.m_y0)){
+        setRectChange(Dest);
+        return;
+    }
+
+    size_t Size = Width * sizeof(RGB);
+    if(dy > 0){
+        for(int16_t PosY = Dest.m_y1 - 1; PosY >= Dest.m_y0; PosY--){
+            memmove(getPtr(Dest.m_x0, PosY), getPtr(SrcX, PosY - dy), Size);
+        }
+    }else{
+        for(int16_t PosY = Dest.m_y0; PosY < Dest.m_y1; PosY++){
+            memmove(getPtr(Dest.m_x0, PosY), getPtr(SrcX, PosY - dy), Size);
+        }
+    }
+    setRectChange(Dest);
+}
+
+// ==========================================================================
+// Défilement vertical
+
+//-----------------------------------------------------------------------------------
+// Défilement de la zone et remplissage des lignes découvertes
+void cGFX::Scroll(int16_t Lines, cColor BackColor){
+    uint16_t Height = getScrollHeight();
+    if((Height == 0) || (Lines == 0)) return;
+    scrollArea(Lines);
+
+    uint16_t NbLines = (Lines > 0) ? Lines : -Lines;
+    if(NbLines > Height) NbLines = Height;
+    int16_t y = (Lines > 0) ? getScrollTop() + Height - NbLines : getScrollTop();
+    drawFillRect(0, y, getWidth(), NbLines, BackColor);
+}
+
 // ==========================================================================
 // Dessiner du texte
 
@@ -347,33 +1525,45 @@ void cGFX::drawImage(uint16_t x, uint16_t y, cImage &Image){
 void cGFX::drawChar(const char c, bool Erase){
     const GFXglyph *pTable = m_pFont->getGFXglyph(c);
     const uint8_t *pBitmap = m_pFont->getBitmap(c);
-    uint8_t BitMap = *pBitmap++;
-    uint8_t numBit = 0;
-    uint8_t indexX;
-    RGB * pFrame;
-    
-    for (uint8_t indexY=0; indexY < pTable->height; indexY ++){
-        indexX = 0;
-        pFrame = getPtr(m_xCursor+pTable->xOffset, indexY+m_yCursor+pTable->yOffset);
-        while (indexX < pTable->width){
-            if((BitMap&0x80) != 0){
-                if(Erase){
-                    pFrame->set(m_TextBackColor);
+    cColor Color = Erase ? m_TextBackColor : m_TextFrontColor;
+
+    // Boite englobante du glyphe
+    int16_t xGlyph = m_xCursor + pTable->xOffset;
+    int16_t yGlyph = m_yCursor + pTable->yOffset;
+    sRect Box = {xGlyph, yGlyph, (int16_t)(xGlyph + pTable->width), (int16_t)(yGlyph + pTable->height)};
+    if(Box.Overlaps(m_Clip)){
+        // Glyphe entièrement visible : aucun test par pixel
+        bool Inside = m_Clip.Contains(Box.m_x0, Box.m_y0, Box.m_x1, Box.m_y1);
+        Box.Intersect(m_Clip);
+        setRectChange(Box);
+        uint8_t BitMap = *pBitmap++;
+        uint8_t numBit = 0;
+        uint8_t indexX;
+        RGB * pFrame = nullptr;
+        
+        for (uint8_t indexY=0; indexY < pTable->height; indexY ++){
+            indexX = 0;
+            if(Inside) pFrame = getPtr(xGlyph, yGlyph + indexY);
+            while (indexX < pTable->width){
+                if((BitMap&0x80) != 0){
+                    if(Inside){
+                        pFrame->set(Color);
+                    }else{
+                        plot(xGlyph + indexX, yGlyph + indexY, Color, false);
+                    }
+                }
+                if(Inside) pFrame++;
+                numBit++;
+                if(numBit > 7){
+                    numBit = 0;
+                    BitMap = *pBitmap++;
                 }else{
-                    pFrame->set(m_TextFrontColor);
+                    BitMap <<= 1 ;
                 }
+                indexX++;
             }
-            pFrame++;
-            numBit++;
-            if(numBit > 7){
-                numBit = 0;
-                BitMap = *pBitmap++;
-            }else{
-                BitMap <<= 1 ;
-            }
-            indexX++;
         }
-    }  
+    }
     m_xCursor += pTable->xAdvance;
 }
 
@@ -387,6 +1577,52 @@ void cGFX::drawText(const char *Text, bool Erase){
     }
 }
 
+//-----------------------------------------------------------------------------------
+// Dessiner une mise en page de texte alignée dans un rectangle
+void cGFX::drawLayout(cTextLayout &Layout, int16_t x, int16_t y, uint16_t dx, uint16_t dy,
+                      TextAlign Align, TextVAlign VAlign, bool Erase){
+    drawFillRect(x, y, dx, dy, m_TextBackColor);
+    drawTransLayout(Layout, x, y, dx, dy, Align, VAlign, Erase);
+}
+
+//-----------------------------------------------------------------------------------
+// Dessiner une mise en page de texte sans couleur d'arrière plan
+// Utilise les mesures de la mise en page, le texte n'est pas mesuré à nouveau
+void cGFX::drawTransLayout(cTextLayout &Layout, int16_t x, int16_t y, uint16_t dx, uint16_t dy,
+                           TextAlign Align, TextVAlign VAlign, bool Erase){
+    cFont *pFont = m_pFont;
+    m_pFont = Layout.getFont();
+
+    // Position verticale du bloc de texte
+    int16_t yText = y;
+    if(VAlign == TextVAlign::Center){
+        yText += ((int16_t)dy - (int16_t)Layout.getHeight()) / 2;
+    }else if(VAlign == TextVAlign::Bottom){
+        yText += (int16_t)dy - (int16_t)Layout.getHeight();
+    }
+    int16_t yLine = yText + m_pFont->getPosHeight();
+
+    const char *pText = Layout.getText();
+    for(uint8_t Line = 0; Line < Layout.getNbLines(); Line++){
+        const sTextLine &TextLine = Layout.getLine(Line);
+
+        // Position horizontale de la ligne
+        int16_t xLine = x;
+        if(Align == TextAlign::Center){
+            xLine += ((int16_t)dx - (int16_t)TextLine.m_Width) / 2;
+        }else if(Align == TextAlign::Right){
+            xLine += (int16_t)dx - (int16_t)TextLine.m_Width;
+        }
+
+        setCursor(xLine, yLine);
+        for(uint16_t Index = TextLine.m_Start; Index < (TextLine.m_Start + TextLine.m_Length); Index++){
+            drawChar(pText[Index], Erase);
+        }
+        yLine += m_pFont->getGFXfont()->yAdvance;
+    }
+    m_pFont = pFont;
+}
+
 //-----------------------------------------------------------------------------------
 // Dessiner le texte sans couleur d'arriere plan
 void cGFX::drawTransText(const char *Text, bool Erase){
@@ -394,4 +1630,117 @@ void cGFX::drawTransText(const char *Text, bool Erase){
     while(*pText != '\0'){
         drawChar(*pText++, Erase);
     }
-}
\ No newline at end of file
+}
+// ==========================================================================
+// Dessiner des valeurs numériques
+
+//-----------------------------------------------------------------------------------
+// Dessiner un entier
+void cGFX::drawInt(int32_t Value, uint8_t NbChar, bool Erase){
+    char Buff[13];
+    FormatFixed(Buff, Value, 0);
+    drawNumber(Buff, NbChar, Erase);
+}
+
+//-----------------------------------------------------------------------------------
+// Dessiner une valeur en virgule fixe : Value / 10^Decimals
+void cGFX::drawFixed(int32_t Value, uint8_t Decimals, uint8_t NbChar, bool Erase){
+    char Buff[13];
+    FormatFixed(Buff, Value, Decimals);
+    drawNumber(Buff, NbChar, Erase);
+}
+
+//-----------------------------------------------------------------------------------
+// Dessiner un flottant arrondi à Decimals décimales
+void cGFX::drawFloat(float Value, uint8_t Decimals, uint8_t NbChar, bool Erase){
+    if(Decimals > 9) Decimals = 9;
+    float Scaled = Value;
+    for(uint8_t Index = 0; Index < Decimals; Index++){
+        Scaled *= 10.0f;
+    }
+    // Arrondi et saturation sur 32 bits
+    Scaled += (Scaled < 0.0f) ? -0.5f : 0.5f;
+    int32_t Fixed;
+    if(Scaled >= 2147483647.0f){
+        Fixed = INT32_MAX;
+    }else if(Scaled <= -2147483648.0f){
+        Fixed = INT32_MIN;
+    }else{
+        Fixed = (int32_t) Scaled;
+    }
+    drawFixed(Fixed, Decimals, NbChar, Erase);
+}
+
+//-----------------------------------------------------------------------------------
+// Conversion d'une valeur en virgule fixe en chaine de caractères
+// Les chiffres sont produits en partant des unités, sans division 64 bits ni printf
+uint8_t cGFX::FormatFixed(char *pBuff, int32_t Value, uint8_t Decimals){
+    if(Decimals > 9) Decimals = 9;
+    char Digits[10];
+    uint8_t NbDigits = 0;
+    uint32_t AbsValue = (Value < 0) ? (uint32_t)0 - (uint32_t)Value : (uint32_t)Value;
+
+    // Chiffres de poids faible en premier
+    do{
+        Digits[NbDigits++] = '0' + (AbsValue % 10);
+        AbsValue /= 10;
+    }while(AbsValue != 0);
+
+    // Il faut au moins un chiffre devant le point décimal
+    while(NbDigits <= Decimals){
+        Digits[NbDigits++] = '0';
+    }
+
+    char *pText = pBuff;
+    if(Value < 0){
+        *pText++ = '-';
+    }
+    while(NbDigits != 0){
+        if((NbDigits == Decimals) && (Decimals != 0)){
+            *pText++ = '.';
+        }
+        *pText++ = Digits[--NbDigits];
+    }
+    *pText = '\0';
+    return pText - pBuff;
+}
+
+//-----------------------------------------------------------------------------------
+// Dessiner une valeur numérique formatée, alignée à droite dans son champ
+// Chaque chiffre occupe la largeur du chiffre le plus large de la fonte
+void cGFX::drawNumber(const char *pText, uint8_t NbChar, bool Erase){
+    uint8_t DigitWidth = m_pFont->getDigitWidth();
+
+    // Largeur de la valeur
+    uint16_t TextWidth = 0;
+    for(const char *pChar = pText; *pChar != '\0'; pChar++){
+        if((*pChar >= '0') && (*pChar <= '9')){
+            TextWidth += DigitWidth;
+        }else{
+            TextWidth += m_pFont->getCharWidth(*pChar);
+        }
+    }
+
+    // Effacement du champ complet -> pas de résidu lorsque la valeur raccourcit
+    uint16_t FieldWidth = NbChar * DigitWidth;
+    if(FieldWidth < TextWidth){
+        FieldWidth = TextWidth;
+    }
+    drawFillRect(m_xCursor, m_yCursor-m_pFont->getPosHeight(), FieldWidth, m_pFont->getHeight(), m_TextBackColor);
+
+    // Dessin aligné à droite, chiffres centrés dans leur cellule
+    uint16_t xEnd = m_xCursor + FieldWidth;
+    m_xCursor = xEnd - TextWidth;
+    while(*pText != '\0'){
+        char c = *pText++;
+        if((c >= '0') && (c <= '9')){
+            uint16_t xCell = m_xCursor;
+            m_xCursor += (DigitWidth - m_pFont->getCharWidth(c)) / 2;
+            drawChar(c, Erase);
+            m_xCursor = xCell + DigitWidth;
+        }else{
+            drawChar(c, Erase);
+        }
+    }
+    m_xCursor = xEnd;
+}
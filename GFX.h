@@ -10,6 +10,30 @@
 #include "Frame.h"
 #define PROGMEM
 
+// Capacité d'une mise en page de texte (cTextLayout)
+// Peut être redéfinie dans UserConfig.h
+#ifndef TEXT_LAYOUT_MAX_LINES
+    #define TEXT_LAYOUT_MAX_LINES 4
+#endif
+#ifndef TEXT_LAYOUT_MAX_CHAR
+    #define TEXT_LAYOUT_MAX_CHAR 64
+#endif
+
+// Profondeur de la pile des zones de découpage (clip)
+// Peut être redéfinie dans UserConfig.h
+#ifndef CLIP_STACK_SIZE
+    #define CLIP_STACK_SIZE 8
+#endif
+
+// Nombre max d'arêtes d'un remplissage de polygone (cPolyEdges)
+// Peut être redéfinie dans UserConfig.h
+#ifndef POLY_MAX_EDGES
+    #define POLY_MAX_EDGES 128
+#endif
+
+class cWidget;
+class cAccel;
+
 constexpr float __PI = 3.14159265358979;
 constexpr float __PI_2 = 1.57079632679489;
 
@@ -42,6 +66,10 @@ public:
     inline uint16_t getHeight(){
         return m_Height;
     } 
+    // Lecture du format des pixels
+    inline TypeImage getType(){
+        return m_Type;
+    } 
     // Lecture de l'adresse du premier pixel de la la ligne spécifiée
     inline const uint8_t* GetPtrLine(uint16_t Line){
         switch(m_Type){
@@ -87,6 +115,48 @@ protected :
     const uint8_t* m_pImage;
 };
 
+//***********************************************************************************
+// cCanvas
+//  Surface hors écran (taille quelconque, pixels RGB prémultipliés comme les
+//  calques) placée dans n'importe quelle mémoire. Sélectionnée par
+//  cGFX::setCanvas() elle reçoit toutes les primitives, puis elle est copiée
+//  dans la frame par cGFX::drawCanvas() ou utilisée comme image.
+//*********************************************************************************** 
+class cCanvas {
+public:
+    friend class cGFX;
+
+    // --------------------------------------------------------------------------
+    // Initialisation : le canevas est transparent
+    // pBuff doit contenir Width * Height pixels
+    void Init(RGB *pBuff, uint16_t Width, uint16_t Height);
+
+    // --------------------------------------------------------------------------
+    // Effacement complet du canevas (transparent)
+    void Clear();
+
+    inline uint16_t getWidth(){
+        return m_Width;
+    }
+    inline uint16_t getHeight(){
+        return m_Height;
+    }
+
+    // --------------------------------------------------------------------------
+    // Image R8G8B8A8 des pixels du canevas (drawImage, cDisplayList::addImage)
+    // Exacte pour les pixels opaques ou transparents, les pixels semi-transparents
+    // sont prémultipliés : utiliser drawCanvas() pour les composer.
+    inline cImage &getImage(){
+        return m_Image;
+    }
+
+protected:
+    RGB         *m_pPixels = nullptr;       // Pixels du canevas
+    uint16_t    m_Width = 0;
+    uint16_t    m_Height = 0;
+    cImage      m_Image = cImage(0, 0, TypeImage::R8G8B8A8, nullptr);
+};
+
 //***********************************************************************************
 // CFont
 // Gestion des polices de caratères
@@ -163,6 +233,14 @@ public:
         return m_NegHeight;
     }
 
+    // --------------------------------------------------------------------------
+    // Lecture de la largeur max des chiffres '0' à '9'
+    // Utilisée pour aligner les valeurs numériques sans variation de largeur
+    inline uint8_t getDigitWidth()
+    {
+        return m_DigitWidth;
+    }
+
     // --------------------------------------------------------------------------
     // Lecture de l'adresse du descripteur de font
     inline const GFXfont *getGFXfont() { return m_pFont; }
@@ -193,6 +271,156 @@ protected:
 
     int8_t m_PosHeight; // Hauteur au dessus de la ligne du curseur
     int8_t m_NegHeight; // Hauteur sous la ligne du curseur
+    uint8_t m_DigitWidth; // Largeur max des chiffres
+};
+
+//***********************************************************************************
+// cTextLayout
+// Mise en page d'un texte
+//   Le texte est mesuré une seule fois (retours à la ligne, largeur de chaque ligne,
+//   boite englobante, avance de chaque caractère). La mise en page peut ensuite
+//   être dessinée autant de fois que nécessaire sans nouvelle mesure.
+//   Le texte n'est pas copié, il doit rester valide tant que la mise en page est utilisée.
+
+// Alignement horizontal
+enum class TextAlign {
+    Left,
+    Center,
+    Right
+};
+
+// Alignement vertical
+enum class TextVAlign {
+    Top,
+    Center,
+    Bottom
+};
+
+// Description d'une ligne
+struct sTextLine {
+    uint16_t m_Start;   // Index du premier caractère de la ligne
+    uint16_t m_Length;  // Nombre de caractères de la ligne
+    uint16_t m_Width;   // Largeur de la ligne en pixels
+};
+
+// cTextLayout
+class cTextLayout
+{
+public:
+    // --------------------------------------------------------------------------
+    // Constructeur
+    cTextLayout() {}
+
+    // --------------------------------------------------------------------------
+    // Mise en page du texte
+    //   MaxWidth : largeur max d'une ligne, les lignes sont coupées sur les espaces
+    //              (0 -> seuls les '\n' provoquent un retour à la ligne)
+    //   Les caractères au delà de TEXT_LAYOUT_MAX_CHAR et les lignes au delà de
+    //   TEXT_LAYOUT_MAX_LINES sont ignorés.
+    void Layout(cFont *pFont, const char *Text, uint16_t MaxWidth = 0);
+
+    // --------------------------------------------------------------------------
+    // Lecture de la largeur de la boite englobante
+    inline uint16_t getWidth() { return m_Width; }
+
+    // --------------------------------------------------------------------------
+    // Lecture de la hauteur de la boite englobante
+    inline uint16_t getHeight() { return m_Height; }
+
+    // --------------------------------------------------------------------------
+    // Lecture du nombre de lignes
+    inline uint8_t getNbLines() { return m_NbLines; }
+
+    // --------------------------------------------------------------------------
+    // Lecture de la description d'une ligne
+    inline const sTextLine &getLine(uint8_t Line) { return m_Lines[Line]; }
+
+    // --------------------------------------------------------------------------
+    // Lecture de l'avance du caractère d'index Index
+    inline uint8_t getAdvance(uint16_t Index) { return m_Advance[Index]; }
+
+    // --------------------------------------------------------------------------
+    // Lecture du texte et de la fonte
+    inline const char *getText() { return m_pText; }
+    inline cFont *getFont() { return m_pFont; }
+
+    // --------------------------------------------------------------------------
+    // Données de la classe
+protected:
+    cFont       *m_pFont = nullptr;                 // Fonte utilisée pour la mesure
+    const char  *m_pText = nullptr;                 // Texte mis en page
+    uint16_t    m_NbChar = 0;                       // Nombre de caractères mesurés
+    uint8_t     m_Advance[TEXT_LAYOUT_MAX_CHAR];    // Avance de chaque caractère
+    sTextLine   m_Lines[TEXT_LAYOUT_MAX_LINES];     // Description des lignes
+    uint8_t     m_NbLines = 0;                      // Nombre de lignes
+    uint16_t    m_Width = 0;                        // Largeur de la boite englobante
+    uint16_t    m_Height = 0;                       // Hauteur de la boite englobante
+};
+
+//***********************************************************************************
+// cPolyEdges
+// Table des arêtes d'un remplissage de polygone par balayage
+//   Les sommets sont en virgule fixe 16.16, une coordonnée entière correspond au
+//   centre d'un pixel. Un pixel est rempli si son centre est à l'intérieur
+//   (bord gauche inclus, bord droit exclu).
+//   Plusieurs contours peuvent être ajoutés à la même table : la règle de
+//   l'enroulement non nul remplit leur union et chaque pixel n'est écrit qu'une fois.
+
+// Point d'un polygone ou d'une polyligne
+struct sPoint {
+    int16_t x;
+    int16_t y;
+};
+
+// Jointure entre les segments d'une polyligne épaisse
+enum class LineJoin {
+    Bevel,      // Coin coupé
+    Miter,      // Coin en pointe (coupé si l'angle est trop aigu)
+    Round       // Coin arrondi (et extrémités arrondies)
+};
+
+// Arête d'un polygone
+struct sPolyEdge {
+    int32_t m_x;        // Abscisse sur la ligne courante (16.16)
+    int32_t m_dxdy;     // Variation de l'abscisse d'une ligne à la suivante (16.16)
+    int16_t m_yStart;   // Première ligne couverte
+    int16_t m_yEnd;     // Ligne de fin (exclue)
+    int8_t  m_Winding;  // +1 arête descendante, -1 arête montante
+};
+
+// cPolyEdges
+class cPolyEdges
+{
+public:
+    // --------------------------------------------------------------------------
+    // Constructeur
+    cPolyEdges() {}
+
+    // --------------------------------------------------------------------------
+    // Vidage de la table
+    inline void Reset() { m_NbEdges = 0; }
+
+    // --------------------------------------------------------------------------
+    // Nombre de places libres dans la table
+    inline uint16_t getFree() { return POLY_MAX_EDGES - m_NbEdges; }
+
+    // --------------------------------------------------------------------------
+    // Ajout d'une arête (16.16). Retourne false si la table est pleine.
+    bool AddEdge(int32_t x0, int32_t y0, int32_t x1, int32_t y1);
+
+    // --------------------------------------------------------------------------
+    // Ajout d'un contour fermé (16.16) orienté dans le sens positif
+    // Retourne false si la table est pleine.
+    bool AddContour(const int32_t *px, const int32_t *py, uint16_t NbPoints);
+
+    // --------------------------------------------------------------------------
+    // Données de la classe
+    friend class cGFX;
+protected:
+    sPolyEdge   m_Edges[POLY_MAX_EDGES];    // Table des arêtes
+    uint16_t    m_Sorted[POLY_MAX_EDGES];   // Arêtes triées par première ligne
+    uint16_t    m_Active[POLY_MAX_EDGES];   // Liste des arêtes actives
+    uint16_t    m_NbEdges = 0;              // Nombre d'arêtes dans la table
 };
 
 //***********************************************************************************
@@ -212,48 +440,221 @@ public:
     //   pFIFO_Data pointe sur la mémoire du FIFO DMA utilisé pour les transfers SPI 
     //              doit etre obligatoirement instancié dans la SDRAM D1 (DMA_BUFFER_MEM_SECTION)
     //   Width, Height taille de l'écran
+    //   L'initialisation de l'écran se poursuit sans bloquer (voir InitTick())
     //
     void Init(RGB *pFrameBuff, FIFO_Data *pFIFO_Data, uint16_t Width, uint16_t Height)
     {
         setFrame(pFrameBuff, pFIFO_Data, Width, Height);
+        resetClip();
     }
     
+    // --------------------------------------------------------------------------
+    // Initialisation en mode tuile (sans frame complète)
+    //   pTile : TILE_SIZE pixels. Le dessin n'est possible qu'entre beginTile() et
+    //   endTile(), limité au bloc en construction (voir cDisplayList::Render()).
+    void InitTile(RGB *pTile, FIFO_Data *pFIFO_Data, uint16_t Width, uint16_t Height)
+    {
+        setTileFrame(pTile, pFIFO_Data, Width, Height);
+        resetClip();
+    }
+
     // --------------------------------------------------------------------------
     // Changer l'orientation de l'écran
+    // La zone de découpage est réinitialisée à la taille de la frame
+    // Un demi-tour conserve le contenu de la frame, l'écran est mis à jour par le
+    // FlushFrame() suivant. Un quart de tour l'efface : sans calque, l'écran n'est
+    // mis à jour qu'au premier FlushFrame() qui suit un dessin.
     void setRotation(Rotation r)
     {
         setFrameRotation(r);
+        resetClip();
     }
     
+    // --------------------------------------------------------------------------
+    // Initialisation de l'écran
+    //   Init() ne bloque pas : l'écran est initialisé par InitTick(), appelée par
+    //   FlushFrame() ou directement depuis la boucle principale. Les modifications
+    //   de la frame sont transmises dès que l'écran est prêt.
+    inline bool InitTick() { return cRBG_Frame::InitTick(); }
+    inline bool isReady() { return isTFTReady(); }
+
     // --------------------------------------------------------------------------
     // Transmette les modifications de la frame à l'écran
     inline void FlushFrame() { cRBG_Frame::FlushFrame();}
 
+    //   Hauteur (en blocs) des bandes regroupées en fenêtres lors de la transmission
+    //   0 : hauteur choisie automatiquement selon les blocs modifiés
+    inline void setBandHeight(uint8_t BandHeight) { cRBG_Frame::setBandHeight(BandHeight); }
+    inline uint8_t getBandHeight() { return cRBG_Frame::getBandHeight(); }
+
+    // --------------------------------------------------------------------------
+    // Calques
+    //   Ajout d'un calque au dessus des précédents (même taille que la frame)
+    inline bool addLayer(cLayer *pLayer) { return cRBG_Frame::addLayer(pLayer); }
+
+    //   Les primitives dessinent dans pLayer, ou dans la frame si pLayer = nullptr.
+    //   Lorsque des calques sont utilisés la frame est recalculée par FlushFrame()
+    //   pour chaque bloc modifié dans un calque : il faut alors dessiner uniquement
+    //   dans les calques.
+    inline void setLayer(cLayer *pLayer) { setDrawLayer(pLayer); }
+
+    // --------------------------------------------------------------------------
+    // Défilement vertical (voir cRBG_Frame::setScrollArea())
+    //   Zone de défilement : lignes Top à Top + Height - 1, Height = 0 -> aucune zone
+    inline bool setScrollArea(uint16_t Top, uint16_t Height) { return cRBG_Frame::setScrollArea(Top, Height); }
+
+    //   Défilement de Lines lignes (Lines > 0 : le contenu monte). Les lignes
+    //   découvertes sont remplies avec BackColor, seules elles sont transmises
+    //   lorsque le défilement est réalisé par l'écran.
+    void Scroll(int16_t Lines, cColor BackColor);
+
+    // --------------------------------------------------------------------------
+    // Accélérateur des remplissages, copies et images (voir Accel.h)
+    //   Les zones d'au moins ACCEL_MIN_PIXELS pixels lui sont confiées, sa fin est
+    //   attendue avant tout autre accès aux pixels. nullptr -> CPU uniquement
+    inline void setAccel(cAccel *pAccel) { cRBG_Frame::setAccel(pAccel); }
+    inline void waitAccel() { cRBG_Frame::waitAccel(); }
+
+    // --------------------------------------------------------------------------
+    // Mode tuile : construction et transmission d'un bloc
+    //   La zone de découpage est limitée au bloc en construction
+    inline bool isTileMode() { return cRBG_Frame::isTileMode(); }
+    inline void beginTile(uint16_t x, uint16_t y) { cRBG_Frame::beginTile(x, y); resetClip(); }
+    inline void endTile() { cRBG_Frame::endTile(); resetClip(); }
+
+    // ==========================================================================
+    // Zone de découpage (clip)
+    //   Toutes les primitives sont limitées à la zone de découpage courante.
+    //   Chaque primitive calcule une seule fois l'intersection de sa boite englobante
+    //   avec cette zone, les boucles de tracé ne font ensuite aucun test.
+    // ==========================================================================
+    // Ajout d'une zone de découpage, intersectée avec la zone courante
+    // Retourne false si la pile est pleine (la zone courante est conservée)
+    bool pushClip(int16_t x, int16_t y, int16_t dx, int16_t dy);
+
+    // Retour à la zone de découpage précédente
+    void popClip();
+
+    // Zone de découpage = frame complète, la pile est vidée
+    // En mode tuile : bloc en construction, zone vide en dehors de beginTile() / endTile()
+    void resetClip();
+
+    // Lecture de la zone de découpage courante
+    inline const sRect &getClip() { return m_Clip; }
+
+    // ==========================================================================
+    // Widgets (voir Widget.h)
+    // ==========================================================================
+    // Redessine uniquement les zones invalidées de l'arbre de widgets pRoot
+    // A appeler avant FlushFrame()
+    void drawWidgets(cWidget *pRoot);
+
     // ==========================================================================
     // Dessiner des formes
     // ==========================================================================
     // Tracer un rectange vide 
-    void drawRect(uint16_t x, uint16_t y, int16_t dx, int16_t dy, cColor Color);
+    void drawRect(int16_t x, int16_t y, int16_t dx, int16_t dy, cColor Color);
     // Tracer un rectangle plein
-    void drawFillRect(uint16_t x, uint16_t y, int16_t dx, int16_t dy, cColor Color);
+    void drawFillRect(int16_t x, int16_t y, int16_t dx, int16_t dy, cColor Color);
+    // Effacer un rectangle (noir transparent pour les calques et les canevas,
+    // noir opaque pour la frame)
+    void eraseRect(int16_t x, int16_t y, int16_t dx, int16_t dy);
     // Trace une ligne
-    void drawLine(uint16_t x, uint16_t y, uint16_t dx, uint16_t dy, cColor Color);
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, cColor Color);
     // Tracer un cercle vide
-    void drawCircle(uint16_t centerX, uint16_t centerY, uint16_t radius, cColor Color);
+    void drawCircle(int16_t centerX, int16_t centerY, uint16_t radius, cColor Color);
     // Tracer un arc de cercle vide
-    void drawArc(uint16_t centerX, uint16_t centerY, uint16_t radius, uint16_t AlphaIn, uint16_t AlphaOut, cColor Color);
+    void drawArc(int16_t centerX, int16_t centerY, uint16_t radius, uint16_t AlphaIn, uint16_t AlphaOut, cColor Color);
     // Tracer un cercle plein
-    void drawFillCircle(uint16_t centerX, uint16_t centerY, uint16_t radius, cColor Color);
+    void drawFillCircle(int16_t centerX, int16_t centerY, uint16_t radius, cColor Color);
+    // Tracer une ellipse pleine
+    void drawFillEllipse(int16_t centerX, int16_t centerY, uint16_t radiusX, uint16_t radiusY, cColor Color);
+    // Tracer un rectangle plein à coins arrondis
+    void drawFillRoundRect(int16_t x, int16_t y, int16_t dx, int16_t dy, uint16_t radius, cColor Color);
+    // Tracer un secteur d'anneau plein (jauge, potentiomètre)
+    //   innerRadius = 0 -> secteur de disque
+    //   Angles en degrés, 0 en haut, sens horaire. Si AlphaIn > AlphaOut le secteur passe par 0.
+    void drawFillArc(int16_t centerX, int16_t centerY, uint16_t innerRadius, uint16_t outerRadius,
+                     uint16_t AlphaIn, uint16_t AlphaOut, cColor Color);
+
+    // ==========================================================================
+    // Dessiner des polygones et des polylignes
+    //   Le remplissage est réalisé par balayage (table des arêtes et liste des arêtes
+    //   actives), chaque pixel n'est écrit qu'une fois.
+    //   Retournent false si le nombre d'arêtes dépasse POLY_MAX_EDGES (rien n'est dessiné)
+    // ==========================================================================
+    // Tracer un polygone plein (concave ou convexe, fermé automatiquement)
+    bool drawFillPolygon(const sPoint *pPoints, uint16_t NbPoints, cColor Color);
+    // Tracer une polyligne d'épaisseur Width
+    //   Width <= 1 -> segments tracés avec drawLine
+    //   Les polylignes longues sont traitées par morceaux de POLY_MAX_EDGES arêtes,
+    //   coupés au milieu d'un segment. Une couleur transparente peut être écrite deux
+    //   fois si la polyligne se croise d'un morceau à l'autre, ou si plusieurs segments
+    //   consécutifs sont plus courts que Width + 2 à l'endroit de la coupure.
+    bool drawPolyline(const sPoint *pPoints, uint16_t NbPoints, uint8_t Width, cColor Color, LineJoin Join = LineJoin::Miter);
+
+    // ==========================================================================
+    // Dessiner des formes anti-aliasées (algorithme de Wu)
+    //   La couverture de chaque pixel est calculée en virgule fixe puis utilisée
+    //   comme transparence de la couleur.
+    //   Les variantes avec BackColor sont réservées au dessin sur un fond uni opaque :
+    //   les couleurs intermédiaires sont précalculées (17 niveaux) et écrites directement.
+    // ==========================================================================
+    // Tracer une ligne anti-aliasée
+    void drawAALine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, cColor Color);
+    void drawAALine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, cColor Color, cColor BackColor);
+    // Tracer un cercle anti-aliasé
+    void drawAACircle(int16_t centerX, int16_t centerY, uint16_t radius, cColor Color);
+    void drawAACircle(int16_t centerX, int16_t centerY, uint16_t radius, cColor Color, cColor BackColor);
+    // Tracer un arc de cercle anti-aliasé (mêmes conventions d'angle que drawArc)
+    void drawAAArc(int16_t centerX, int16_t centerY, uint16_t radius, uint16_t AlphaIn, uint16_t AlphaOut, cColor Color);
+    void drawAAArc(int16_t centerX, int16_t centerY, uint16_t radius, uint16_t AlphaIn, uint16_t AlphaOut, cColor Color, cColor BackColor);
+
+    // ==========================================================================
+    // Dessiner des images
+    // ==========================================================================
     // Tracer une image 8bits par couleurs (depreciated)
-    void drawR8G8B8Image(uint16_t x, uint16_t y, uint16_t dx, uint16_t dy, const uint8_t *pImg);
+    void drawR8G8B8Image(int16_t x, int16_t y, uint16_t dx, uint16_t dy, const uint8_t *pImg);
     // Tracer une image
-    void drawImage(uint16_t x, uint16_t y, cImage &Image);
+    void drawImage(int16_t x, int16_t y, cImage &Image);
+
+    // ==========================================================================
+    // Sauvegarde / restauration de zones (fond des sprites, voir Sprite.h)
+    //   Rect est limité à la frame, la zone de découpage n'est pas utilisée.
+    //   pBuff contient Stride pixels par ligne, son premier pixel correspond au
+    //   coin haut gauche de Rect.
+    // ==========================================================================
+    // Copie d'une zone de la frame dans pBuff
+    void saveRect(const sRect &Rect, RGB *pBuff, uint16_t Stride);
+    // Copie de pBuff dans une zone de la frame, les blocs de la zone sont marqués une seule fois
+    void restoreRect(const sRect &Rect, const RGB *pBuff, uint16_t Stride);
+
+    // ==========================================================================
+    // Dessin hors écran (voir cCanvas)
+    // ==========================================================================
+    // Sélection du canevas qui reçoit les primitives
+    //   pCanvas = nullptr -> retour à la frame (ou au calque de dessin)
+    //   La zone de découpage est réinitialisée à la taille de la destination.
+    //   Le canevas doit être désélectionné avant FlushFrame(), setRotation(),
+    //   setScrollArea() ou beginTile().
+    void setCanvas(cCanvas *pCanvas);
+
+    // Copie d'un canevas en (x, y), composé par dessus la destination
+    void drawCanvas(int16_t x, int16_t y, cCanvas &Canvas);
+
+    // ==========================================================================
+    // Copie / déplacement de zones dans la frame (ou le calque de dessin)
+    // ==========================================================================
+    // Copie de la zone Src en (x, y). Les zones peuvent se recouvrir.
+    //   Src est limitée à la frame, la destination à la zone de découpage.
+    //   Seuls les blocs de la destination sont marqués. Sans effet en mode tuile.
+    void copyRect(const sRect &Src, int16_t x, int16_t y);
 
     // ==========================================================================
     // Dessiner du texte
     // ==========================================================================
     // Positionnement du cuseur
-    inline void setCursor(uint16_t x, uint16_t y){
+    inline void setCursor(int16_t x, int16_t y){
         m_xCursor = x;
         m_yCursor = y;
     };
@@ -266,6 +667,12 @@ public:
     
     // Configuration de la couleur de l'arrière plan du texte
     inline void setTextBackColor(cColor Color) { m_TextBackColor = Color; }
+
+    // Lecture de la couleur du texte
+    inline cColor getTextFrontColor() { return m_TextFrontColor; }
+
+    // Lecture de la couleur de l'arrière plan du texte
+    inline cColor getTextBackColor() { return m_TextBackColor; }
     
     // Dessiner le caractère c
     void drawChar(const char c, bool Erase = false);
@@ -276,11 +683,36 @@ public:
     // Dessiner le texte
     void drawText(const char *Text, bool Erase = false);
 
+    // Dessiner une mise en page de texte alignée dans le rectangle x, y, dx, dy
+    // Le rectangle est effacé avec la couleur d'arrière plan
+    void drawLayout(cTextLayout &Layout, int16_t x, int16_t y, uint16_t dx, uint16_t dy,
+                    TextAlign Align = TextAlign::Left, TextVAlign VAlign = TextVAlign::Top, bool Erase = false);
+
+    // Dessiner une mise en page de texte sans couleur d'arrière plan
+    void drawTransLayout(cTextLayout &Layout, int16_t x, int16_t y, uint16_t dx, uint16_t dy,
+                    TextAlign Align = TextAlign::Left, TextVAlign VAlign = TextVAlign::Top, bool Erase = false);
+
+    // ==========================================================================
+    // Dessiner des valeurs numériques (sans passer par sprintf)
+    //   La valeur est alignée à droite dans un champ de NbChar caractères de la
+    //   largeur d'un chiffre. Les chiffres ont tous la même largeur, le champ
+    //   ne varie donc pas lorsque la valeur change.
+    //   NbChar = 0 -> le champ a la largeur de la valeur
+    // ==========================================================================
+    // Dessiner un entier
+    void drawInt(int32_t Value, uint8_t NbChar = 0, bool Erase = false);
+
+    // Dessiner une valeur en virgule fixe : Value / 10^Decimals
+    void drawFixed(int32_t Value, uint8_t Decimals, uint8_t NbChar = 0, bool Erase = false);
+
+    // Dessiner un flottant arrondi à Decimals décimales
+    void drawFloat(float Value, uint8_t Decimals, uint8_t NbChar = 0, bool Erase = false);
+
     // Lire la position du curseur en X
-    inline uint8_t getXCursor() { return m_xCursor; }
+    inline int16_t getXCursor() { return m_xCursor; }
 
     // Lire la position du curseur en Y
-    inline uint8_t getYCursor() { return m_xCursor; }
+    inline int16_t getYCursor() { return m_yCursor; }
 
     // Lire la fonte courante
     inline cFont *getFont() { return m_pFont; }
@@ -298,10 +730,180 @@ public:
     inline uint8_t getTextHeight(){return m_pFont->getHeight();}
 
     // --------------------------------------------------------------------------
-    // Données de la classe
+    // Fonctions internes
  protected:
-    uint16_t m_xCursor = 0;
-    uint16_t m_yCursor = 0;
+    // Conversion d'une valeur en virgule fixe en chaine de caractères
+    // Retourne le nombre de caractères écrits (pBuff doit contenir au moins 13 caractères)
+    static uint8_t FormatFixed(char *pBuff, int32_t Value, uint8_t Decimals);
+
+    // Dessiner une valeur numérique formatée, alignée à droite dans son champ
+    void drawNumber(const char *pText, uint8_t NbChar, bool Erase);
+
+    // Plages de x (algorithme de Bresenham) couvertes par un arc dans chacun des 8 octants
+    //   Octant 0 : 0 à 45 degrés, octant 1 : 45 à 90 degrés ...
+    struct sArcOctants {
+        int16_t m_Min[8][2];
+        int16_t m_Max[8][2];
+    };
+
+    // Calcul des plages d'un arc
+    static void getArcOctants(sArcOctants &Octants, uint16_t radius, uint16_t AlphaIn, uint16_t AlphaOut);
+
+    // Secteur angulaire d'un arc plein
+    //   Le secteur est l'intersection (angle <= 180) ou l'union (angle > 180)
+    //   de deux demi-plans passant par le centre
+    struct sArcSector {
+        bool    m_Full;     // Secteur de 360 degrés
+        bool    m_Union;    // Union des demi-plans (angle > 180)
+        int32_t m_Sx;       // Direction de départ (Q15)
+        int32_t m_Sy;
+        int32_t m_Ex;       // Direction de fin (Q15)
+        int32_t m_Ey;
+    };
+
+    // Remplissage d'une ligne d'un arc plein
+    //   dy : ordonnée de la ligne par rapport au centre
+    //   HalfOut : demi-largeur du disque extérieur, HalfIn : demi-largeur du trou (-1 -> pas de trou)
+    void fillArcRow(const sArcSector &Sector, int16_t centerX, int16_t y, int32_t dy,
+                    int32_t HalfOut, int32_t HalfIn, cColor Color);
+
+    // --------------------------------------------------------------------------
+    // Marquage des blocs modifiés
+    //   Les fonctions d'écriture de pixels (fillSpan, fillVSpan, plot, plotAA) ne
+    //   marquent aucun bloc : chaque primitive marque une seule fois les blocs
+    //   recouverts par sa boite englobante, limitée à la zone de découpage.
+
+    // Marquage de la boite [x0, x1] x [y0, y1] (bornes incluses)
+    inline void setBoxChange(int32_t x0, int32_t y0, int32_t x1, int32_t y1){
+        if(x0 < m_Clip.m_x0) x0 = m_Clip.m_x0;
+        if(y0 < m_Clip.m_y0) y0 = m_Clip.m_y0;
+        if(x1 >= m_Clip.m_x1) x1 = m_Clip.m_x1 - 1;
+        if(y1 >= m_Clip.m_y1) y1 = m_Clip.m_y1 - 1;
+        if((x0 > x1) || (y0 > y1)) return;
+        setRectChange({(int16_t)x0, (int16_t)y0, (int16_t)(x1 + 1), (int16_t)(y1 + 1)});
+    }
+
+    // Marquage des blocs traversés par une ligne
+    //   La ligne est découpée en tronçons de la taille d'un bloc, seule la boite
+    //   de chaque tronçon est marquée. Margin : pixels ajoutés sur l'axe secondaire.
+    void setLineChange(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t Margin);
+
+    // Marquage des blocs traversés par le contour d'un cercle ou d'un arc (pOctants)
+    //   Quatre boites (haut, bas, gauche, droite) recouvrent les huit octants,
+    //   les blocs intérieurs ne sont pas marqués.
+    void setCircleChange(int16_t centerX, int16_t centerY, uint16_t radius, const sArcOctants *pOctants = nullptr);
+
+    // Remplissage d'une ligne horizontale de x0 à x1 inclus, limitée à la zone de découpage
+    // Chaque pixel n'est écrit qu'une fois
+    inline void fillSpan(int32_t x0, int32_t x1, int32_t y, cColor Color){
+        if((y < m_Clip.m_y0) || (y >= m_Clip.m_y1)) return;
+        if(x0 < m_Clip.m_x0) x0 = m_Clip.m_x0;
+        if(x1 >= m_Clip.m_x1) x1 = m_Clip.m_x1 - 1;
+        if(x0 > x1) return;
+        RGB *pFrame = getPtr(x0, y);
+        RGB *pEnd = pFrame + (x1 - x0);
+        while(pFrame <= pEnd){
+            (pFrame++)->set(Color);
+        }
+    }
+
+    // Remplissage d'une ligne verticale de y0 à y1 inclus, limitée à la zone de découpage
+    inline void fillVSpan(int32_t x, int32_t y0, int32_t y1, cColor Color){
+        if((x < m_Clip.m_x0) || (x >= m_Clip.m_x1)) return;
+        if(y0 < m_Clip.m_y0) y0 = m_Clip.m_y0;
+        if(y1 >= m_Clip.m_y1) y1 = m_Clip.m_y1 - 1;
+        if(y0 > y1) return;
+        if(!isRowsContiguous(y0, y1 + 1)){
+            // La ligne traverse le bord de l'anneau de défilement
+            for(int32_t y = y0; y <= y1; y++){
+                getPtr(x, y)->set(Color);
+            }
+            return;
+        }
+        RGB *pFrame = getPtr(x, y0);
+        for(int32_t y = y0; y <= y1; y++){
+            pFrame->set(Color);
+            pFrame += getStride();
+        }
+    }
+
+    // Ecriture d'un pixel
+    //   Inside = true : la primitive est entièrement dans la zone de découpage, pas de test
+    inline void plot(int16_t x, int16_t y, cColor Color, bool Inside){
+        if(Inside || m_Clip.Contains(x, y)){
+            getPtr(x, y)->set(Color);
+        }
+    }
+
+    // Mode de mélange des primitives anti-aliasées
+    struct sAAColor {
+        uint8_t m_R;
+        uint8_t m_G;
+        uint8_t m_B;
+    };
+    struct sAABlend {
+        cColor   m_Color = cColor(0, 0, 0);   // Couleur du tracé
+        bool     m_LUT = false;               // Utilisation de la table (fond uni opaque)
+        sAAColor m_Table[17];                 // Couleurs pour une couverture de 0, 1/16 ... 16/16
+    };
+
+    // Préparation du mélange, avec table si pBackColor != nullptr
+    static void initAABlend(sAABlend &Blend, cColor Color, const cColor *pBackColor);
+
+    // Ecriture d'un pixel avec une couverture de 0 à 255
+    inline void plotAA(int16_t x, int16_t y, uint8_t Coverage, const sAABlend &Blend){
+        if((Coverage == 0) || !m_Clip.Contains(x, y)) return;
+        if(Blend.m_LUT){
+            const sAAColor &Color = Blend.m_Table[(Coverage + 8) >> 4];
+            getPtr(x, y)->set(cColor(Color.m_R, Color.m_G, Color.m_B));
+        }else{
+            getPtr(x, y)->set(cColor(Blend.m_Color.m_R, Blend.m_Color.m_G, Blend.m_Color.m_B,
+                                     (Blend.m_Color.m_A * (Coverage + 1)) >> 8));
+        }
+    }
+
+    // Tracé anti-aliasé
+    void drawAALine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, const sAABlend &Blend);
+    void drawAACircle(int16_t centerX, int16_t centerY, uint16_t radius, const sArcOctants *pOctants, const sAABlend &Blend);
+
+    // Opérations confiées à l'accélérateur (false -> à réaliser par le CPU)
+    bool isAccelArea(const sRect &Rect);
+    bool accelFill(const sRect &Rect, cColor Color);
+    bool accelCopy(RGB *pDest, uint16_t DestStride, const RGB *pSrc, uint16_t SrcStride,
+                   uint16_t Width, uint16_t Height);
+    bool accelImage(const sRect &Rect, cImage &Image, int16_t x, int16_t y);
+
+    // Rendu des widgets
+    void renderWidget(cWidget *pWidget, const sRect &Painted, const sRect &Limit);
+    void paintWidget(cWidget *pWidget, const sRect &Area);
+
+    // Remplissage des contours de la table des arêtes (règle non nulle)
+    void fillPolyEdges(cPolyEdges &Edges, cColor Color);
+
+    // Ajout de la jointure d'une polyligne au sommet x, y (16.16)
+    //   nx1, ny1 et nx2, ny2 : normales (de longueur demi-épaisseur) des deux segments
+    void addPolyJoin(float x, float y, float nx1, float ny1, float nx2, float ny2, float HalfWidth, LineJoin Join);
+
+    // Ajout du quadrilatère d'un segment de polyligne (nx, ny : normale)
+    void addPolySegment(float x0, float y0, float x1, float y1, float nx, float ny);
+
+    // Ajout d'un disque polygonal de centre x, y (16.16)
+    void addPolyDisc(float x, float y, float Radius);
+
+    // Test si le point x de l'octant appartient à l'arc
+    static inline bool inArcOctant(const sArcOctants &Octants, uint8_t Octant, int16_t x){
+        return ((x >= Octants.m_Min[Octant][0]) && (x <= Octants.m_Max[Octant][0])) ||
+               ((x >= Octants.m_Min[Octant][1]) && (x <= Octants.m_Max[Octant][1]));
+    }
+
+    // --------------------------------------------------------------------------
+    // Données de la classe
+    cPolyEdges m_PolyEdges;     // Table des arêtes des polygones
+    sRect    m_Clip;                            // Zone de découpage courante
+    sRect    m_ClipStack[CLIP_STACK_SIZE];      // Zones de découpage empilées
+    uint8_t  m_ClipDepth = 0;                   // Nombre de zones empilées
+    int16_t  m_xCursor = 0;
+    int16_t  m_yCursor = 0;
     cFont *m_pFont = nullptr;
     cColor m_TextFrontColor = cColor(255, 255, 255);
     cColor m_TextBackColor = cColor(0, 0, 0);
@@ -32,6 +32,9 @@
 #define TFT_MAD_COLOR_ORDER TFT_MAD_RGB
 //#define TFT_MAD_COLOR_ORDER TFT_MAD_BGR
 
+// Orientation à la fin de l'initialisation
+#define TFT_INIT_MADCTL (0xC0 | TFT_MAD_COLOR_ORDER)
+
 // ST7735 specific commands used in init
 #define ST7735_NOP			0x00
 #define ST7735_SWRESET		0x01
@@ -96,85 +99,48 @@
 #define ST7735_PWCTR6       0xFC
 
 // --------------------------------------------------------------------------
-// Initialisation de l'écran de type ST7735        
-void TFT_SPI::Initialise(){
-    // Init for 7735R, part 1 (red or green tab)
-    // -----------------------------------------
-    SendCommand(ST7735_SWRESET);        //  1: Software reset, 0 args, w/delay
-      System::Delay(150);                
-    SendCommand(ST7735_SLPOUT);         //  2: Out of sleep mode, 0 args, w/delay
-      System::Delay(500);                
-    
-    SendCommand(ST7735_FRMCTR1);        //  3: Frame rate ctrl - normal mode
-      SendData(0x01); 
-      SendData(0x2C); 
-      SendData(0x2D);                   //     Rate = fosc/(1x2+40) * (LINE+2C+2D)
-    
-    SendCommand(ST7735_FRMCTR2);        //  4: Frame rate control - idle mode
-      SendData(0x01); 
-      SendData(0x2C); 
-      SendData(0x2D);                   //     Rate = fosc/(1x2+40) * (LINE+2C+2D)
-    
-    SendCommand(ST7735_FRMCTR3);        //  5: Frame rate ctrl - partial mode
-      SendData(0x01); 
-      SendData(0x2C); 
-      SendData(0x2D);                   //     Dot inversion mode
-      SendData(0x01); 
-      SendData(0x2C); 
-      SendData(0x2D);                   //     Line inversion mode
-
-    SendCommand(ST7735_INVCTR);         //  6: Display inversion ctrl
-      SendData(0x07);                   //     No inversion
-    
-    SendCommand(ST7735_PWCTR1);         //  7: Power control
-      SendData(0xA2);
-      SendData(0x02);                   //     -4.6V
-      SendData(0x84);                   //     AUTO mode
-    
-    SendCommand(ST7735_PWCTR2);         //  8: Power control
-      SendData(0xC5);                   //     VGH25 = 2.4C VGSEL = -10 VGH = 3 * AVDD
-    
-    SendCommand(ST7735_PWCTR3 );        //  9: Power control
-      SendData(0x0A);                   //     Opamp current small
-      SendData(0x00);                   //     Boost frequency
-    
-    SendCommand(ST7735_PWCTR4 );        // 10: Power control
-      SendData(0x8A);                   //     BCLK/2); Opamp current small & Medium low
-      SendData(0x2A);  
-
-    SendCommand(ST7735_PWCTR5 );        // 11: Power control
-      SendData(0x8A); SendData(0xEE);
-    
-    SendCommand(ST7735_VMCTR1 );        // 12: Power control
-      SendData(0x0E);
-    
-    SendCommand(ST7735_INVOFF );        // 13: Don't invert display
-    
-    SendCommand(ST7735_MADCTL );        // 14: Memory access control (directions)
-      SendData(0xC0 | TFT_MAD_COLOR_ORDER); //     row addr/col addr); bottom to top refresh
-    
-    SendCommand(ST7735_COLMOD );        // 15: set color mode
+// Table d'initialisation de l'écran de type ST7735
+//   Exécutée par TFT_SPI::InitTick() (voir le format dans TFT_SPI.h)
+//   Init for 7735R, part 1 (red or green tab)
 #if TFT_COLOR == 16
-        SendData(0x05);
+    #define ST7735_COLMOD_ARG 0x05
 #else
-        SendData(0x06);
+    #define ST7735_COLMOD_ARG 0x06
 #endif
 
-    SendCommand(ST7735_GMCTRP1);        // 16: 
-      SendData(0x02); SendData(0x1c); SendData(0x07); SendData(0x12);
-      SendData(0x37); SendData(0x32); SendData(0x29); SendData(0x2d);
-      SendData(0x29); SendData(0x25); SendData(0x2B); SendData(0x39);
-      SendData(0x00); SendData(0x01); SendData(0x03); SendData(0x10);
-    
-    SendCommand(ST7735_GMCTRN1);        // 17:
-      SendData(0x03); SendData(0x1d); SendData(0x07); SendData(0x06);
-      SendData(0x2E); SendData(0x2C); SendData(0x29); SendData(0x2D);
-      SendData(0x2E); SendData(0x2E); SendData(0x37); SendData(0x3F);
-      SendData(0x00); SendData(0x00); SendData(0x02); SendData(0x10);
-    
-    SendCommand(ST7735_NORON);          // 18: Normal display on
-      System::Delay(10);
-    
-    SendCommand(ST7735_DISPON);         // 19: Main screen turn on
-      System::Delay(100);
-}
+static const uint8_t TFT_InitCmds[] = {
+    19,                                     // Nombre de commandes
+    ST7735_SWRESET, TFT_INIT_DELAY, 150,    //  1: Software reset, 0 args, w/delay
+    ST7735_SLPOUT,  TFT_INIT_DELAY, 255,    //  2: Out of sleep mode, 0 args, w/delay (500 ms)
+    ST7735_FRMCTR1, 3, 0x01, 0x2C, 0x2D,    //  3: Frame rate ctrl - normal mode
+                                            //     Rate = fosc/(1x2+40) * (LINE+2C+2D)
+    ST7735_FRMCTR2, 3, 0x01, 0x2C, 0x2D,    //  4: Frame rate control - idle mode
+                                            //     Rate = fosc/(1x2+40) * (LINE+2C+2D)
+    ST7735_FRMCTR3, 6, 0x01, 0x2C, 0x2D,    //  5: Frame rate ctrl - partial mode
+                                            //     Dot inversion mode
+                       0x01, 0x2C, 0x2D,    //     Line inversion mode
+    ST7735_INVCTR,  1, 0x07,                //  6: Display inversion ctrl
+                                            //     No inversion
+    ST7735_PWCTR1,  3, 0xA2, 0x02, 0x84,    //  7: Power control
+                                            //     -4.6V, AUTO mode
+    ST7735_PWCTR2,  1, 0xC5,                //  8: Power control
+                                            //     VGH25 = 2.4C VGSEL = -10 VGH = 3 * AVDD
+    ST7735_PWCTR3,  2, 0x0A, 0x00,          //  9: Power control
+                                            //     Opamp current small, Boost frequency
+    ST7735_PWCTR4,  2, 0x8A, 0x2A,          // 10: Power control
+                                            //     BCLK/2); Opamp current small & Medium low
+    ST7735_PWCTR5,  2, 0x8A, 0xEE,          // 11: Power control
+    ST7735_VMCTR1,  1, 0x0E,                // 12: Power control
+    ST7735_INVOFF,  0,                      // 13: Don't invert display
+    ST7735_MADCTL,  1, TFT_INIT_MADCTL,     // 14: Memory access control (directions)
+                                            //     row addr/col addr); bottom to top refresh
+    ST7735_COLMOD,  1, ST7735_COLMOD_ARG,   // 15: set color mode
+    ST7735_GMCTRP1, 16,                     // 16:
+        0x02, 0x1c, 0x07, 0x12, 0x37, 0x32, 0x29, 0x2d,
+        0x29, 0x25, 0x2B, 0x39, 0x00, 0x01, 0x03, 0x10,
+    ST7735_GMCTRN1, 16,                     // 17:
+        0x03, 0x1d, 0x07, 0x06, 0x2E, 0x2C, 0x29, 0x2D,
+        0x2E, 0x2E, 0x37, 0x3F, 0x00, 0x00, 0x02, 0x10,
+    ST7735_NORON,   TFT_INIT_DELAY, 10,     // 18: Normal display on
+    ST7735_DISPON,  TFT_INIT_DELAY, 100     // 19: Main screen turn on
+};
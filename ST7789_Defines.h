@@ -86,108 +86,49 @@
 //#define TFT_MAD_COLOR_ORDER TFT_MAD_RGB
 #define TFT_MAD_COLOR_ORDER TFT_MAD_BGR
 
-// --------------------------------------------------------------------------
-// Initialisation de l'écran de type ST7789
-
- void TFT_SPI::Initialise(){
-    
-    SendCommand(ST7789_SLPOUT);   // Sleep out
-    System::Delay(120);
-    SendCommand(ST7789_NORON);    // Normal display mode on
-
-    //------------------------------display and color format setting--------------------------------//
-    SendCommand(ST7789_MADCTL);
-    SendData(TFT_MAD_COLOR_ORDER);
-
-    // JLX240 display datasheet
-    SendCommand(0xB6);
-    SendData(0x0A);
-    SendData(0x82);
+// Orientation à la fin de l'initialisation
+#define TFT_INIT_MADCTL TFT_MAD_COLOR_ORDER
 
-    //SendCommand(ST7789_RAMCTRL);
-    SendData(0x00);
-    SendData(0xC0); // 5 to 6-bit conversion: r0 = r5, b0 = b5
-
-    SendCommand(ST7789_COLMOD);
+// --------------------------------------------------------------------------
+// Table d'initialisation de l'écran de type ST7789
+//   Exécutée par TFT_SPI::InitTick() (voir le format dans TFT_SPI.h)
 #if TFT_COLOR == 16
-        SendData(0x55);
+    #define ST7789_COLMOD_ARG 0x55
 #else
-        SendData(0x66);
+    #define ST7789_COLMOD_ARG 0x66
 #endif
-    System::Delay(10);
 
-    //--------------------------------ST7789V Frame rate setting----------------------------------//
-    SendCommand(ST7789_PORCTRL);
-    SendData(0x0c);
-    SendData(0x0c);
-    SendData(0x00);
-    SendData(0x33);
-    SendData(0x33);
+static const uint8_t TFT_InitCmds[] = {
+    19,                                         // Nombre de commandes
+    ST7789_SLPOUT,    TFT_INIT_DELAY, 120,      // Sleep out
+    ST7789_NORON,     0,                        // Normal display mode on
 
-    SendCommand(ST7789_GCTRL);      // Voltages: VGH / VGL
-    SendData(0x35);
-
-    //---------------------------------ST7789V Power setting--------------------------------------//
-    SendCommand(ST7789_VCOMS);
-    SendData(0x28);		// JLX240 display datasheet
-
-    SendCommand(ST7789_LCMCTRL);
-    SendData(0x0C);
-
-    SendCommand(ST7789_VDVVRHEN);
-    SendData(0x01);
-    SendData(0xFF);
-
-    SendCommand(ST7789_VRHS);       // voltage VRHS
-    SendData(0x10);
-
-    SendCommand(ST7789_VDVSET);
-    SendData(0x20);
+    //------------------------------display and color format setting--------------------------------//
+    ST7789_MADCTL,    1, TFT_INIT_MADCTL,
+    0xB6,             4, 0x0A, 0x82,            // JLX240 display datasheet
+                         0x00, 0xC0,            // (RAMCTRL non émise : 5 to 6-bit conversion: r0 = r5, b0 = b5)
+    ST7789_COLMOD,    1 | TFT_INIT_DELAY, ST7789_COLMOD_ARG, 10,
 
-    SendCommand(ST7789_FRCTR2);
-    SendData(0x0f);
+    //--------------------------------ST7789V Frame rate setting----------------------------------//
+    ST7789_PORCTRL,   5, 0x0c, 0x0c, 0x00, 0x33, 0x33,
+    ST7789_GCTRL,     1, 0x35,                  // Voltages: VGH / VGL
 
-    SendCommand(ST7789_PWCTRL1);
-    SendData(0xa4);
-    SendData(0xa1);
+    //---------------------------------ST7789V Power setting--------------------------------------//
+    ST7789_VCOMS,     1, 0x28,                  // JLX240 display datasheet
+    ST7789_LCMCTRL,   1, 0x0C,
+    ST7789_VDVVRHEN,  2, 0x01, 0xFF,
+    ST7789_VRHS,      1, 0x10,                  // voltage VRHS
+    ST7789_VDVSET,    1, 0x20,
+    ST7789_FRCTR2,    1, 0x0f,
+    ST7789_PWCTRL1,   2, 0xa4, 0xa1,
 
     //--------------------------------ST7789V gamma setting---------------------------------------//
-    SendCommand(ST7789_PVGAMCTRL);
-    SendData(0xd0);
-    SendData(0x00);
-    SendData(0x02);
-    SendData(0x07);
-    SendData(0x0a);
-    SendData(0x28);
-    SendData(0x32);
-    SendData(0x44);
-    SendData(0x42);
-    SendData(0x06);
-    SendData(0x0e);
-    SendData(0x12);
-    SendData(0x14);
-    SendData(0x17);
-
-    SendCommand(ST7789_NVGAMCTRL);
-    SendData(0xd0);
-    SendData(0x00);
-    SendData(0x02);
-    SendData(0x07);
-    SendData(0x0a);
-    SendData(0x28);
-    SendData(0x31);
-    SendData(0x54);
-    SendData(0x47);
-    SendData(0x0e);
-    SendData(0x1c);
-    SendData(0x17);
-    SendData(0x1b);
-    SendData(0x1e);
-
-    SendCommand(ST7789_INVON);
-    SendCommand(ST7789_INVON);
-    System::Delay(120);
-
-    SendCommand(ST7789_DISPON);    //Display on
-    System::Delay(120);
-}
\ No newline at end of file
+    ST7789_PVGAMCTRL, 14, 0xd0, 0x00, 0x02, 0x07, 0x0a, 0x28, 0x32,
+                          0x44, 0x42, 0x06, 0x0e, 0x12, 0x14, 0x17,
+    ST7789_NVGAMCTRL, 14, 0xd0, 0x00, 0x02, 0x07, 0x0a, 0x28, 0x31,
+                          0x54, 0x47, 0x0e, 0x1c, 0x17, 0x1b, 0x1e,
+
+    ST7789_INVON,     0,
+    ST7789_INVON,     TFT_INIT_DELAY, 120,
+    ST7789_DISPON,    TFT_INIT_DELAY, 120       //Display on
+};
@@ -0,0 +1,130 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2024 Dad Design.
+//      Oscilloscope : affichage d'une forme d'onde en continu
+//------------------------------------------------------------------------
+#include "Scope.h"
+
+//***********************************************************************************
+// cScope
+//***********************************************************************************
+
+// --------------------------------------------------------------------------
+// Initialisation et dessin du fond
+void cScope::Init(cGFX *pGFX, int16_t x, int16_t y, uint16_t Width, uint16_t Height,
+                  uint16_t SamplesPerColumn, cColor TraceColor, cColor BackColor){
+    if(Width > SCOPE_MAX_WIDTH) Width = SCOPE_MAX_WIDTH;
+    if(Height < 1) Height = 1;
+    if(SamplesPerColumn < 1) SamplesPerColumn = 1;
+
+    m_pGFX = pGFX;
+    m_x = x;
+    m_y = y;
+    m_Width = Width;
+    m_Height = Height;
+    m_SamplesPerColumn = SamplesPerColumn;
+    m_Center = (Height - 1) / 2;
+    m_Scale = (float)((Height - 1) / 2);
+    m_TraceColor = TraceColor;
+    m_BackColor = BackColor;
+
+    m_Read.store(m_Write.load(std::memory_order_acquire), std::memory_order_release);
+    m_Column = 0;
+    m_NbSamples = 0;
+    m_LastRow = m_Center;
+    Redraw();
+}
+
+// --------------------------------------------------------------------------
+// Ajout d'un bloc d'échantillons (producteur)
+// Pas de Step entre deux échantillons (ex : 2 pour un canal d'un buffer entrelacé)
+uint16_t cScope::PushBlock(const float *pSamples, uint16_t Size, uint16_t Step){
+    uint32_t Write = m_Write.load(std::memory_order_relaxed);
+    uint32_t Free = SCOPE_RING_SIZE - (Write - m_Read.load(std::memory_order_acquire));
+    if(Size > Free) Size = Free;
+    for(uint16_t Index = 0; Index < Size; Index++){
+        m_Ring[(Write + Index) & (SCOPE_RING_SIZE - 1)] = *pSamples;
+        pSamples += Step;
+    }
+    m_Write.store(Write + Size, std::memory_order_release);
+    return Size;
+}
+
+// --------------------------------------------------------------------------
+// Lecture des échantillons disponibles et mise à jour des colonnes modifiées
+void cScope::Update(){
+    uint32_t Write = m_Write.load(std::memory_order_acquire);
+    uint32_t Read = m_Read.load(std::memory_order_relaxed);
+
+    // En cas de retard, on ne garde que les échantillons d'un balayage complet
+    uint32_t MaxSamples = (uint32_t)m_Width * m_SamplesPerColumn;
+    if((Write - Read) > MaxSamples){
+        Read = Write - MaxSamples;
+        m_NbSamples = 0;
+    }
+
+    while(Read != Write){
+        int16_t Row = SampleToRow(m_Ring[Read & (SCOPE_RING_SIZE - 1)]);
+        Read++;
+
+        // Le dernier point de la colonne précédente assure la continuité de la trace
+        if(m_NbSamples == 0){
+            m_AccMin = m_LastRow;
+            m_AccMax = m_LastRow;
+        }
+        if(Row < m_AccMin) m_AccMin = Row;
+        if(Row > m_AccMax) m_AccMax = Row;
+
+        if(++m_NbSamples >= m_SamplesPerColumn){
+            setColumn(m_Column, m_AccMin, m_AccMax);
+            m_LastRow = Row;
+            m_NbSamples = 0;
+            if(++m_Column >= m_Width){
+                m_Column = 0;
+            }
+        }
+    }
+    m_Read.store(Read, std::memory_order_release);
+}
+
+// --------------------------------------------------------------------------
+// Redessine entièrement l'oscilloscope (sans effet avant Init())
+void cScope::Redraw(){
+    if(m_pGFX == nullptr) return;
+    m_pGFX->drawFillRect(m_x, m_y, m_Width, m_Height, m_BackColor);
+    for(uint16_t Column = 0; Column < m_Width; Column++){
+        m_Min[Column] = 1;
+        m_Max[Column] = 0;
+    }
+}
+
+// --------------------------------------------------------------------------
+// Changement de couleurs
+void cScope::setColors(cColor TraceColor, cColor BackColor){
+    m_TraceColor = TraceColor;
+    m_BackColor = BackColor;
+    Redraw();
+}
+
+// --------------------------------------------------------------------------
+// Tracé d'une colonne terminée
+// Seules les lignes qui quittent ou rejoignent l'étendue de la colonne sont écrites,
+// une colonne identique à la précédente ne modifie aucun pixel.
+void cScope::setColumn(uint16_t Column, int16_t Min, int16_t Max){
+    int16_t OldMin = m_Min[Column];
+    int16_t OldMax = m_Max[Column];
+    if((OldMin == Min) && (OldMax == Max)) return;
+
+    if(OldMin > OldMax){
+        // Colonne vide
+        fillColumn(Column, Min, Max, m_TraceColor);
+    }else{
+        // Effacement des lignes qui ne font plus partie de la trace
+        fillColumn(Column, OldMin, (OldMax < Min - 1) ? OldMax : Min - 1, m_BackColor);
+        fillColumn(Column, (OldMin > Max + 1) ? OldMin : Max + 1, OldMax, m_BackColor);
+        // Tracé des nouvelles lignes
+        fillColumn(Column, Min, (Max < OldMin - 1) ? Max : OldMin - 1, m_TraceColor);
+        fillColumn(Column, (Min > OldMax + 1) ? Min : OldMax + 1, Max, m_TraceColor);
+    }
+    m_Min[Column] = Min;
+    m_Max[Column] = Max;
+}
@@ -0,0 +1,119 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2024 Dad Design.
+//      Oscilloscope : affichage d'une forme d'onde en continu
+//
+//      Les échantillons sont écrits par le callback audio dans un buffer
+//      circulaire sans verrou (un seul producteur, un seul consommateur).
+//      La boucle principale les réduit en un min/max par colonne et ne
+//      redessine que les colonnes dont l'étendue verticale a changé.
+//------------------------------------------------------------------------
+#pragma once
+#include <atomic>
+#include "GFX.h"
+
+// Taille du buffer circulaire des échantillons (puissance de 2)
+// Peut être redéfinie dans UserConfig.h
+#ifndef SCOPE_RING_SIZE
+    #define SCOPE_RING_SIZE 1024
+#endif
+
+// Largeur max d'un oscilloscope en colonnes
+// Peut être redéfinie dans UserConfig.h
+#ifndef SCOPE_MAX_WIDTH
+    #define SCOPE_MAX_WIDTH 320
+#endif
+
+static_assert((SCOPE_RING_SIZE & (SCOPE_RING_SIZE - 1)) == 0, "SCOPE_RING_SIZE doit être une puissance de 2");
+
+//***********************************************************************************
+// cScope
+// Oscilloscope en mode balayage : les nouvelles colonnes remplacent les anciennes
+// de gauche à droite, puis le balayage reprend à gauche.
+//
+// Une colonne regroupe SamplesPerColumn échantillons, elle est tracée comme un
+// segment vertical du min au max (le dernier point de la colonne précédente est
+// inclus pour que la trace reste continue). Lorsqu'une colonne change, seules les
+// lignes qui apparaissent ou disparaissent sont écrites.
+//***********************************************************************************
+class cScope {
+public:
+    // --------------------------------------------------------------------------
+    // Initialisation et dessin du fond
+    //   Les échantillons sont attendus dans [-1, 1]
+    void Init(cGFX *pGFX, int16_t x, int16_t y, uint16_t Width, uint16_t Height,
+              uint16_t SamplesPerColumn, cColor TraceColor, cColor BackColor);
+
+    // ==========================================================================
+    // Producteur (callback audio)
+    // ==========================================================================
+    // Ajout d'un échantillon, retourne false si le buffer est plein (échantillon perdu)
+    inline bool Push(float Sample){
+        uint32_t Write = m_Write.load(std::memory_order_relaxed);
+        if((Write - m_Read.load(std::memory_order_acquire)) >= SCOPE_RING_SIZE) return false;
+        m_Ring[Write & (SCOPE_RING_SIZE - 1)] = Sample;
+        m_Write.store(Write + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Ajout d'un bloc d'échantillons, l'index d'écriture n'est publié qu'une fois
+    // Retourne le nombre d'échantillons effectivement ajoutés
+    uint16_t PushBlock(const float *pSamples, uint16_t Size, uint16_t Step = 1);
+
+    // ==========================================================================
+    // Consommateur (boucle principale)
+    // ==========================================================================
+    // Lecture des échantillons disponibles et mise à jour des colonnes modifiées
+    void Update();
+
+    // Redessine entièrement l'oscilloscope
+    void Redraw();
+
+    // Changement de couleurs (redessine l'oscilloscope)
+    void setColors(cColor TraceColor, cColor BackColor);
+
+protected:
+    // Conversion d'un échantillon en ligne relative à m_y
+    inline int16_t SampleToRow(float Sample){
+        int32_t Row = m_Center - (int32_t)(Sample * m_Scale);
+        if(Row < 0) Row = 0;
+        if(Row >= m_Height) Row = m_Height - 1;
+        return Row;
+    }
+
+    // Tracé d'une colonne terminée
+    void setColumn(uint16_t Column, int16_t Min, int16_t Max);
+
+    // Remplissage des lignes y0 à y1 incluses d'une colonne
+    inline void fillColumn(uint16_t Column, int16_t y0, int16_t y1, cColor Color){
+        if(y0 <= y1){
+            m_pGFX->drawFillRect(m_x + Column, m_y + y0, 1, y1 - y0 + 1, Color);
+        }
+    }
+
+    // Buffer circulaire
+    float                   m_Ring[SCOPE_RING_SIZE];
+    std::atomic<uint32_t>   m_Write{0};         // Index d'écriture (producteur)
+    std::atomic<uint32_t>   m_Read{0};          // Index de lecture (consommateur)
+
+    // Etendue tracée de chaque colonne (lignes relatives, Min > Max : colonne vide)
+    int16_t                 m_Min[SCOPE_MAX_WIDTH];
+    int16_t                 m_Max[SCOPE_MAX_WIDTH];
+
+    // Colonne en cours de construction
+    uint16_t                m_Column = 0;       // Colonne courante du balayage
+    uint16_t                m_NbSamples = 0;    // Echantillons déjà lus pour cette colonne
+    int16_t                 m_AccMin = 0;
+    int16_t                 m_AccMax = 0;
+    int16_t                 m_LastRow = 0;      // Dernière ligne de la colonne précédente
+
+    cGFX                   *m_pGFX = nullptr;
+    int16_t                 m_x = 0;
+    int16_t                 m_y = 0;
+    uint16_t                m_Width = 0;
+    uint16_t                m_Height = 0;
+    uint16_t                m_SamplesPerColumn = 1;
+    int16_t                 m_Center = 0;
+    float                   m_Scale = 0;
+    cColor                  m_TraceColor = cColor(255, 255, 255);
+    cColor                  m_BackColor = cColor(0, 0, 0);
+};
@@ -0,0 +1,177 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2024 Dad Design.
+//      Sprites : images mobiles avec sauvegarde et restauration du fond
+//------------------------------------------------------------------------
+#include "Sprite.h"
+
+//***********************************************************************************
+// cSprite
+//***********************************************************************************
+
+// --------------------------------------------------------------------------
+// Initialisation
+void cSprite::Init(cImage *pImage, RGB *pSaveBuff, int16_t x, int16_t y, uint8_t Z){
+    m_pImage = pImage;
+    m_pSave = pSaveBuff;
+    m_x = x;
+    m_y = y;
+    m_Z = Z;
+    m_Visible = true;
+    m_Change = true;
+    m_Shown = false;
+    m_Drawn = {0, 0, 0, 0};
+}
+
+// --------------------------------------------------------------------------
+// Changement d'image
+void cSprite::setImage(cImage *pImage){
+    m_pImage = pImage;
+    m_Change = true;
+}
+
+// --------------------------------------------------------------------------
+// Positionnement absolu
+void cSprite::setPosition(int16_t x, int16_t y){
+    if((x == m_x) && (y == m_y)) return;
+    m_x = x;
+    m_y = y;
+    m_Change = true;
+}
+
+// --------------------------------------------------------------------------
+// Changement de l'ordre d'affichage
+void cSprite::setZ(uint8_t Z){
+    if(Z == m_Z) return;
+    m_Z = Z;
+    m_Change = true;
+}
+
+// --------------------------------------------------------------------------
+// Affichage / masquage
+void cSprite::setVisible(bool Visible){
+    if(Visible == m_Visible) return;
+    m_Visible = Visible;
+    m_Change = true;
+}
+
+//***********************************************************************************
+// cSpriteList
+//***********************************************************************************
+
+// --------------------------------------------------------------------------
+// Initialisation
+void cSpriteList::Init(cGFX *pGFX){
+    m_pGFX = pGFX;
+    m_NbSprites = 0;
+}
+
+// --------------------------------------------------------------------------
+// Ajout d'un sprite
+bool cSpriteList::addSprite(cSprite *pSprite){
+    if(m_NbSprites >= SPRITE_MAX) return false;
+    pSprite->m_Change = true;
+    m_pSprites[m_NbSprites++] = pSprite;
+    return true;
+}
+
+// --------------------------------------------------------------------------
+// Mise à jour de la frame
+void cSpriteList::Update(){
+    // Sprites modifiés
+    bool Change = false;
+    for(uint8_t Index = 0; Index < m_NbSprites; Index++){
+        cSprite *pSprite = m_pSprites[Index];
+        pSprite->m_Affected = pSprite->m_Change;
+        Change |= pSprite->m_Change;
+    }
+    if(!Change) return;
+
+    // Propagation aux sprites qui se recouvrent, jusqu'à stabilité
+    bool Propagate = true;
+    while(Propagate){
+        Propagate = false;
+        for(uint8_t Index = 0; Index < m_NbSprites; Index++){
+            cSprite *pSprite = m_pSprites[Index];
+            if(pSprite->m_Affected) continue;
+            for(uint8_t Other = 0; Other < m_NbSprites; Other++){
+                if(m_pSprites[Other]->m_Affected && Overlaps(pSprite, m_pSprites[Other])){
+                    pSprite->m_Affected = true;
+                    Propagate = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Restauration du fond, dans l'ordre inverse du dessin
+    for(int16_t Index = m_NbSprites - 1; Index >= 0; Index--){
+        if(m_pSprites[Index]->m_Affected) Restore(m_pSprites[Index]);
+    }
+
+    // Sauvegarde du fond et dessin, par Z croissant
+    SortZ();
+    for(uint8_t Index = 0; Index < m_NbSprites; Index++){
+        cSprite *pSprite = m_pSprites[Index];
+        if(!pSprite->m_Affected) continue;
+        pSprite->m_Affected = false;
+        pSprite->m_Change = false;
+        if(!pSprite->m_Visible) continue;
+
+        pSprite->m_Drawn = pSprite->getRect();
+        m_pGFX->saveRect(pSprite->m_Drawn, pSprite->m_pSave, pSprite->m_pImage->getWith());
+        m_pGFX->drawImage(pSprite->m_x, pSprite->m_y, *pSprite->m_pImage);
+        pSprite->m_Shown = true;
+    }
+}
+
+// --------------------------------------------------------------------------
+// Effacement de tous les sprites
+void cSpriteList::Erase(){
+    for(int16_t Index = m_NbSprites - 1; Index >= 0; Index--){
+        Restore(m_pSprites[Index]);
+        m_pSprites[Index]->m_Change = true;
+    }
+}
+
+// --------------------------------------------------------------------------
+// Test si deux sprites se recouvrent
+// Zones prises en compte : fond sauvegardé (si affiché) et nouvelle position (si visible)
+bool cSpriteList::Overlaps(cSprite *pSprite1, cSprite *pSprite2){
+    sRect Rect1[2];
+    sRect Rect2[2];
+    uint8_t Nb1 = 0;
+    uint8_t Nb2 = 0;
+    if(pSprite1->m_Shown) Rect1[Nb1++] = pSprite1->m_Drawn;
+    if(pSprite1->m_Visible) Rect1[Nb1++] = pSprite1->getRect();
+    if(pSprite2->m_Shown) Rect2[Nb2++] = pSprite2->m_Drawn;
+    if(pSprite2->m_Visible) Rect2[Nb2++] = pSprite2->getRect();
+
+    for(uint8_t Index1 = 0; Index1 < Nb1; Index1++){
+        for(uint8_t Index2 = 0; Index2 < Nb2; Index2++){
+            if(Rect1[Index1].Overlaps(Rect2[Index2])) return true;
+        }
+    }
+    return false;
+}
+
+// --------------------------------------------------------------------------
+// Restauration du fond d'un sprite
+void cSpriteList::Restore(cSprite *pSprite){
+    if(!pSprite->m_Shown) return;
+    m_pGFX->restoreRect(pSprite->m_Drawn, pSprite->m_pSave, pSprite->m_Drawn.m_x1 - pSprite->m_Drawn.m_x0);
+    pSprite->m_Shown = false;
+}
+
+// --------------------------------------------------------------------------
+// Tri des sprites par Z croissant (tri par insertion, stable)
+void cSpriteList::SortZ(){
+    for(uint8_t Index = 1; Index < m_NbSprites; Index++){
+        cSprite *pSprite = m_pSprites[Index];
+        int16_t Pos = Index - 1;
+        while((Pos >= 0) && (m_pSprites[Pos]->m_Z > pSprite->m_Z)){
+            m_pSprites[Pos + 1] = m_pSprites[Pos];
+            Pos--;
+        }
+        m_pSprites[Pos + 1] = pSprite;
+    }
+}
@@ -0,0 +1,117 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2024 Dad Design.
+//      Sprites : images mobiles avec sauvegarde et restauration du fond
+//
+//      Le fond recouvert par chaque sprite est sauvegardé dans un petit buffer
+//      avant son dessin. Lorsqu'un sprite change, son fond est restauré puis le
+//      sprite est redessiné à sa nouvelle position : seuls les blocs de l'ancienne
+//      et de la nouvelle zone sont transmis.
+//------------------------------------------------------------------------
+#pragma once
+#include "GFX.h"
+
+// Nombre max de sprites d'une liste
+// Peut être redéfinie dans UserConfig.h
+#ifndef SPRITE_MAX
+    #define SPRITE_MAX 16
+#endif
+
+//***********************************************************************************
+// cSprite
+// Les modifications sont appliquées au prochain cSpriteList::Update().
+//***********************************************************************************
+class cSprite {
+public:
+    friend class cSpriteList;
+
+    // --------------------------------------------------------------------------
+    // Initialisation
+    //   pSaveBuff : buffer de sauvegarde du fond, largeur x hauteur de l'image
+    //   Z : ordre d'affichage, les sprites de Z élevé sont dessinés au dessus
+    void Init(cImage *pImage, RGB *pSaveBuff, int16_t x, int16_t y, uint8_t Z = 0);
+
+    // --------------------------------------------------------------------------
+    // Changement d'image
+    // La nouvelle image ne doit pas contenir plus de pixels que le buffer de sauvegarde
+    void setImage(cImage *pImage);
+
+    // Positionnement absolu
+    void setPosition(int16_t x, int16_t y);
+
+    // Déplacement relatif
+    inline void Move(int16_t dx, int16_t dy){
+        setPosition(m_x + dx, m_y + dy);
+    }
+
+    // Changement de l'ordre d'affichage
+    void setZ(uint8_t Z);
+
+    // Affichage / masquage
+    void setVisible(bool Visible);
+
+    // --------------------------------------------------------------------------
+    // Lecture
+    inline int16_t getX() { return m_x; }
+    inline int16_t getY() { return m_y; }
+    inline uint8_t getZ() { return m_Z; }
+    inline bool isVisible() { return m_Visible; }
+
+protected:
+    // Zone couverte par le sprite à sa position courante
+    inline sRect getRect(){
+        return {m_x, m_y, (int16_t)(m_x + m_pImage->getWith()), (int16_t)(m_y + m_pImage->getHeight())};
+    }
+
+    cImage     *m_pImage = nullptr;
+    RGB        *m_pSave = nullptr;          // Fond sauvegardé
+    int16_t     m_x = 0;
+    int16_t     m_y = 0;
+    uint8_t     m_Z = 0;
+    bool        m_Visible = true;
+    bool        m_Change = true;            // A redessiner au prochain Update()
+    bool        m_Shown = false;            // Dessiné dans la frame, fond sauvegardé
+    bool        m_Affected = false;         // Update() : fond à restaurer et sprite à redessiner
+    sRect       m_Drawn = {0, 0, 0, 0};     // Zone du fond sauvegardé
+};
+
+//***********************************************************************************
+// cSpriteList
+// Les sprites sont dessinés dans la destination courante du dessin (frame ou
+// calque). Le fond situé sous un sprite affiché ne doit pas être redessiné
+// directement : appeler Erase(), dessiner le fond, puis Update().
+// Le mode tuile n'est pas supporté.
+//***********************************************************************************
+class cSpriteList {
+public:
+    // --------------------------------------------------------------------------
+    // Initialisation : liste vide
+    void Init(cGFX *pGFX);
+
+    // Ajout d'un sprite, retourne false si la liste est pleine
+    bool addSprite(cSprite *pSprite);
+
+    // --------------------------------------------------------------------------
+    // Mise à jour de la frame
+    //   Les sprites modifiés, et ceux qui les recouvrent ou sont recouverts par eux,
+    //   sont effacés (fond restauré, du premier plan vers le fond) puis redessinés
+    //   par ordre de Z croissant.
+    void Update();
+
+    // Effacement de tous les sprites (fond restauré), ils sont redessinés au
+    // prochain Update()
+    void Erase();
+
+protected:
+    // Test si deux sprites se recouvrent (ancienne ou nouvelle zone)
+    static bool Overlaps(cSprite *pSprite1, cSprite *pSprite2);
+
+    // Restauration du fond d'un sprite
+    void Restore(cSprite *pSprite);
+
+    // Tri des sprites par Z croissant (tri stable)
+    void SortZ();
+
+    cSprite    *m_pSprites[SPRITE_MAX];     // Sprites, dans l'ordre de dessin
+    uint8_t     m_NbSprites = 0;
+    cGFX       *m_pGFX = nullptr;
+};
@@ -62,30 +62,87 @@ void TFT_SPI::Init_TFT_SPI(){
     // Initialize SPI
     m_spi.Init(m_spi_config);
     
-    // Reset LCD
-    m_reset.Write(false);
-    System::Delay(50);
-    m_reset.Write(true);
-    System::Delay(50);
+    // Reset LCD, la suite est réalisée par InitTick()
+    m_Madctl = TFT_INIT_MADCTL;
+    resetRST();
+    m_InitState = TFTInit::Reset;
+    m_InitStart = System::GetNow();
+    m_InitWait = TFT_RESET_DELAY;
+}
+
+// --------------------------------------------------------------------------
+// Poursuite de l'initialisation de l'écran
+bool TFT_SPI::InitTick(){
+    if(m_InitState == TFTInit::Ready) return true;
+    if((System::GetNow() - m_InitStart) < m_InitWait) return false;
+
+    switch(m_InitState){
+    case TFTInit::Reset :
+        // Fin du reset, attente avant la première commande
+        setRST();
+        m_pInitCmd = &TFT_InitCmds[1];
+        m_InitNbCmds = TFT_InitCmds[0];
+        m_InitState = TFTInit::Commands;
+        m_InitStart = System::GetNow();
+        m_InitWait = TFT_RESET_DELAY;
+        return false;
+
+    case TFTInit::Commands :
+        // Envoi des commandes jusqu'à la prochaine attente
+        while(m_InitNbCmds != 0){
+            m_InitNbCmds--;
+            uint8_t Cmd = *m_pInitCmd++;
+            uint8_t NbArgs = *m_pInitCmd++;
+            bool Wait = (NbArgs & TFT_INIT_DELAY) != 0;
+            NbArgs &= ~TFT_INIT_DELAY;
 
-    Initialise();
+            SendCommand(Cmd);
+            if(NbArgs != 0){
+                SendData(const_cast<uint8_t *>(m_pInitCmd), NbArgs);
+                m_pInitCmd += NbArgs;
+            }
+            if(Wait){
+                uint8_t Delay = *m_pInitCmd++;
+                m_InitStart = System::GetNow();
+                m_InitWait = (Delay == 255) ? 500 : Delay;
+                return false;
+            }
+        }
+        m_InitState = TFTInit::Ready;
+        return true;
+
+    default :
+        return true;
+    }
+}
+
+// --------------------------------------------------------------------------
+// Initialisation bloquante
+void TFT_SPI::Initialise(){
+    while(InitTick() == false){
+        System::Delay(1);
+    }
 }
  
 // Set the display image orientation to 0, 1, 2 or 3
 void  TFT_SPI::setTFTRotation(Rotation r){
+    m_Madctl = getMADCTL(r);
     SendCommand(TFT_MADCTL);
+    SendData(m_Madctl);
+}
+
+// --------------------------------------------------------------------------
+// Valeur de MADCTL pour une orientation
+uint8_t TFT_SPI::getMADCTL(Rotation r){
     switch (r) {
-    case Rotation::Degre_0 : // Portrait
-        SendData(TFT_MAD_COLOR_ORDER);
-        break;
     case Rotation::Degre_90 : // Landscape (Portrait + 90)
-        SendData(TFT_MAD_MX | TFT_MAD_MV | TFT_MAD_COLOR_ORDER);
-        break;
+        return TFT_MAD_MX | TFT_MAD_MV | TFT_MAD_COLOR_ORDER;
     case Rotation::Degre_180 : // Inverter portrait
-        SendData(TFT_MAD_MX | TFT_MAD_MY | TFT_MAD_COLOR_ORDER);
-        break;
+        return TFT_MAD_MX | TFT_MAD_MY | TFT_MAD_COLOR_ORDER;
     case Rotation::Degre_270 : // Inverted landscape
-        SendData(TFT_MAD_MV | TFT_MAD_MY | TFT_MAD_COLOR_ORDER);
-        break;
+        return TFT_MAD_MV | TFT_MAD_MY | TFT_MAD_COLOR_ORDER;
+    case Rotation::Degre_0 : // Portrait
+    default :
+        return TFT_MAD_COLOR_ORDER;
     }
 }
@@ -23,7 +23,9 @@
 #define TFT_RASET   0x2B
 #define TFT_RAMWR   0x2C
 
+#define TFT_VSCRDEF  0x33
 #define TFT_MADCTL  0x36
+#define TFT_VSCRSADD 0x37
 #define TFT_MAD_MY  0x80
 #define TFT_MAD_MX  0x40
 #define TFT_MAD_MV  0x20
@@ -32,6 +34,16 @@
 #define TFT_MAD_MH  0x04
 #define TFT_MAD_RGB 0x00
 
+// Nombre de lignes de la mémoire de l'écran (zones de défilement vertical)
+// Peut être redéfinie dans UserConfig.h
+#ifndef TFT_GRAM_HEIGHT
+    #if TFT_CONTROLEUR_TFT == 7789
+        #define TFT_GRAM_HEIGHT 320
+    #else
+        #define TFT_GRAM_HEIGHT TFT_HEIGHT
+    #endif
+#endif
+
 
 using namespace daisy;
 extern DaisySeed hw;
@@ -50,6 +62,22 @@ enum class Rotation{
     Degre_270
 };
 
+// Table d'initialisation de l'écran (TFT_InitCmds dans STxxxx_Defines.h)
+//   Nombre de commandes, puis pour chaque commande :
+//   Commande, Nombre d'arguments (| TFT_INIT_DELAY), Arguments, [Attente en ms si TFT_INIT_DELAY]
+//   Une attente de 255 correspond à 500 ms
+#define TFT_INIT_DELAY 0x80
+
+// Durée des phases de reset de l'écran en ms
+#define TFT_RESET_DELAY 50
+
+// Etapes de l'initialisation de l'écran
+enum class TFTInit : uint8_t {
+    Reset,          // Broche reset à 0
+    Commands,       // Envoi de la table d'initialisation
+    Ready           // Ecran prêt
+};
+
 // Configuration des GPIO utilisés
 #define _TFT_SPI_PORT SpiHandle::Config::Peripheral::TFT_SPI_PORT
 #define _TFT_SPI_MODE SPIMode::TFT_SPI_MODE
@@ -68,16 +96,34 @@ class TFT_SPI {
     public :
 
 	// --------------------------------------------------------------------------
-	// Initialisation du SPI
+	// Initialisation du SPI et lancement de l'initialisation de l'écran
+    // Ne bloque pas : l'initialisation est poursuivie par InitTick()
     void Init_TFT_SPI();
     
     // --------------------------------------------------------------------------
-	// Initialisation
+	// Poursuite de l'initialisation de l'écran, sans attente
+    // A appeler régulièrement (boucle principale ou timer) jusqu'à ce qu'elle
+    // retourne true. Les commandes de la table sont envoyées jusqu'à la
+    // prochaine attente, dont la fin est testée à l'appel suivant.
+    bool InitTick();
+
+    // --------------------------------------------------------------------------
+	// Initialisation bloquante : attend la fin de l'initialisation de l'écran
     void Initialise();
 
+    // --------------------------------------------------------------------------
+	// Ecran initialisé
+    inline bool isTFTReady(){
+        return m_InitState == TFTInit::Ready;
+    }
+
     // --------------------------------------------------------------------------
 	// Modification de l'orientation de l'écran
     void setTFTRotation(Rotation r);
+
+    // --------------------------------------------------------------------------
+	// Valeur de MADCTL pour une orientation
+    static uint8_t getMADCTL(Rotation r);
     
     // --------------------------------------------------------------------------
     // Emission d'une commande
@@ -138,7 +184,7 @@ class TFT_SPI {
     }
     
     inline void resetRST(){
-        m_reset.Write(true);       
+        m_reset.Write(false);       
     }
     
     // --------------------------------------------------------------------------
@@ -149,4 +195,13 @@ class TFT_SPI {
     
     GPIO                m_reset;
     GPIO                m_dc;
+
+    uint8_t             m_Madctl = 0;           // Orientation de l'écran (MADCTL) en vigueur
+
+    // Initialisation de l'écran
+    TFTInit             m_InitState = TFTInit::Reset;
+    const uint8_t      *m_pInitCmd = nullptr;   // Prochaine commande de la table
+    uint8_t             m_InitNbCmds = 0;       // Nombre de commandes restant à envoyer
+    uint32_t            m_InitStart = 0;        // Début de l'attente en cours (ms)
+    uint32_t            m_InitWait = 0;         // Durée de l'attente en cours (ms)
 };
@@ -12,6 +12,10 @@
 //#define TFT_CONTROLEUR_TFT  7789
 #define TFT_CONTROLEUR_TFT  7735
 
+// Nombre de lignes de la mémoire de l'écran, utilisé par le défilement vertical
+// Par défaut : 320 pour le 7789, TFT_HEIGHT pour le 7735
+//#define TFT_GRAM_HEIGHT 320
+
 // Pour info codage des couleurs
 // 18 Codage 18 bits RGB666
 // 16 Codage 16 bits RGB565
@@ -35,8 +39,45 @@
 //   -> On me transmet à l'écran que les blocs qui ont été modifiés
 // Ex : ecran 240x320 / FRAME_GRILLE 10 -> Bloc = 24x32
 // Attention la hauteur et la largeur  doivent être divisibles par FRAME_GRILLE
+// FRAME_GRILLE est limité à 64
 #define FRAME_GRILLE 8
 
 // Taille du FIFO pour la transmission SPI des blocs par le DMA
 // Attention nombre limité car le FIFO est placé dans la SRAM D1 qui semble être utilisée aussi par un autre process
-#define SIZE_FIFO 10
\ No newline at end of file
+#define SIZE_FIFO 10
+
+// Capacité d'une mise en page de texte (cTextLayout)
+#define TEXT_LAYOUT_MAX_LINES 4     // Nombre max de lignes
+#define TEXT_LAYOUT_MAX_CHAR 64     // Nombre max de caractères
+
+// Nombre max d'arêtes pour le remplissage des polygones et des polylignes épaisses
+#define POLY_MAX_EDGES 128
+
+// Profondeur de la pile des zones de découpage (pushClip / popClip)
+#define CLIP_STACK_SIZE 8
+
+// Oscilloscope (cScope)
+#define SCOPE_RING_SIZE 1024        // Taille du buffer circulaire des échantillons (puissance de 2)
+#define SCOPE_MAX_WIDTH 320         // Largeur max en colonnes
+
+// Bargraphe (cBarGraph)
+#define BARGRAPH_MAX_BARS 64        // Nombre max de barres
+
+// Nombre max de commandes d'une liste d'affichage (cDisplayList)
+#define DISPLAY_LIST_SIZE 64
+
+// Nombre max de calques composés dans la frame (cLayer)
+#define LAYER_MAX 4
+
+// Nombre max de sprites d'une liste (cSpriteList)
+#define SPRITE_MAX 16
+
+// Transmission : hauteur (en blocs) des bandes regroupées en fenêtres (0 -> automatique)
+#define FLUSH_BAND_HEIGHT 1
+#define FLUSH_DMA_SETUP_BYTES 24     // Octets émis pendant le lancement d'un transfert DMA
+#define FLUSH_WINDOW_COST (11 + (5 * FLUSH_DMA_SETUP_BYTES)) // Coût d'une fenêtre en octets
+#define FLUSH_TUNE_FRAMES 32         // Transmissions observées par choix automatique
+#define FLUSH_SOLID_PIXELS 256       // Motif des suites de pixels d'une seule couleur (0 -> pas de détection)
+
+// Nombre min de pixels d'une zone confiée à l'accélérateur (cAccel)
+#define ACCEL_MIN_PIXELS 512
\ No newline at end of file
@@ -0,0 +1,173 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2024 Dad Design.
+//      Widgets : arbre de zones d'affichage avec suivi des zones à redessiner
+//------------------------------------------------------------------------
+#include "Widget.h"
+
+//***********************************************************************************
+// cWidget
+//***********************************************************************************
+
+// --------------------------------------------------------------------------
+// Initialisation
+void cWidget::Init(int16_t x, int16_t y, uint16_t dx, uint16_t dy, WidgetDrawCallback pDraw,
+                   void *pContext, bool Opaque){
+    m_Bounds = {x, y, (int16_t)(x + dx), (int16_t)(y + dy)};
+    m_pDraw = pDraw;
+    m_pContext = pContext;
+    m_Opaque = Opaque;
+    m_Visible = true;
+    m_Damage = m_Bounds;
+}
+
+// --------------------------------------------------------------------------
+// Ajout d'un enfant en fin de liste
+void cWidget::addChild(cWidget *pChild){
+    pChild->m_pParent = this;
+    pChild->m_pNext = nullptr;
+    if(m_pFirstChild == nullptr){
+        m_pFirstChild = pChild;
+    }else{
+        cWidget *pLast = m_pFirstChild;
+        while(pLast->m_pNext != nullptr) pLast = pLast->m_pNext;
+        pLast->m_pNext = pChild;
+    }
+    pChild->Invalidate();
+}
+
+// --------------------------------------------------------------------------
+// Invalidation d'une partie du widget
+// Un widget non opaque transmet l'invalidation à son parent qui redessinera
+// la zone, enfants compris
+void cWidget::InvalidateRect(const sRect &Area){
+    sRect Rect = Area;
+    Rect.Intersect(m_Bounds);
+    if(Rect.isEmpty() || !m_Visible) return;
+
+    if(!m_Opaque && (m_pParent != nullptr)){
+        m_pParent->InvalidateRect(Rect);
+    }else{
+        m_Damage.Union(Rect);
+        setAncestorsChanged();
+    }
+}
+
+// --------------------------------------------------------------------------
+// Invalidation d'une zone libérée par le widget (déplacement, masquage)
+void cWidget::InvalidateArea(const sRect &Area){
+    if(m_pParent != nullptr){
+        m_pParent->InvalidateRect(Area);
+    }else{
+        m_Damage.Union(Area);
+    }
+}
+
+// --------------------------------------------------------------------------
+// Signale aux ancêtres qu'un descendant doit être redessiné
+void cWidget::setAncestorsChanged(){
+    for(cWidget *pParent = m_pParent; (pParent != nullptr) && !pParent->m_ChildChange; pParent = pParent->m_pParent){
+        pParent->m_ChildChange = true;
+    }
+}
+
+// --------------------------------------------------------------------------
+// Changement des limites du widget
+void cWidget::setBounds(int16_t x, int16_t y, uint16_t dx, uint16_t dy){
+    if(m_Visible) InvalidateArea(m_Bounds);
+    m_Bounds = {x, y, (int16_t)(x + dx), (int16_t)(y + dy)};
+    Invalidate();
+}
+
+// --------------------------------------------------------------------------
+// Déplacement relatif du widget et de ses enfants
+void cWidget::Move(int16_t dx, int16_t dy){
+    if(m_Visible) InvalidateArea(m_Bounds);
+    Translate(dx, dy);
+    Invalidate();
+}
+
+// --------------------------------------------------------------------------
+// Déplacement des limites du widget et de sa descendance
+void cWidget::Translate(int16_t dx, int16_t dy){
+    m_Bounds.m_x0 += dx;
+    m_Bounds.m_x1 += dx;
+    m_Bounds.m_y0 += dy;
+    m_Bounds.m_y1 += dy;
+    m_Damage = {0, 0, 0, 0};
+    for(cWidget *pChild = m_pFirstChild; pChild != nullptr; pChild = pChild->m_pNext){
+        pChild->Translate(dx, dy);
+    }
+}
+
+// --------------------------------------------------------------------------
+// Affichage / masquage
+void cWidget::setVisible(bool Visible){
+    if(m_Visible == Visible) return;
+    if(Visible){
+        m_Visible = true;
+        Invalidate();
+    }else{
+        InvalidateArea(m_Bounds);
+        m_Visible = false;
+        m_Damage = {0, 0, 0, 0};
+    }
+}
+
+//***********************************************************************************
+// cGFX : rendu des widgets
+//***********************************************************************************
+
+// --------------------------------------------------------------------------
+// Redessine les zones invalidées de l'arbre de widgets
+void cGFX::drawWidgets(cWidget *pRoot){
+    sRect Painted = {0, 0, 0, 0};
+    renderWidget(pRoot, Painted, m_Clip);
+}
+
+// --------------------------------------------------------------------------
+// Rendu des zones invalidées d'un widget et de ses descendants
+//   Painted : zone déjà redessinée par un ancêtre, les zones invalidées qu'elle
+//   contient ne sont pas redessinées une seconde fois
+//   Limit : intersection des limites des ancêtres
+void cGFX::renderWidget(cWidget *pWidget, const sRect &Painted, const sRect &Limit){
+    sRect Damage = pWidget->m_Damage;
+    pWidget->m_Damage = {0, 0, 0, 0};
+    bool ChildChange = pWidget->m_ChildChange;
+    pWidget->m_ChildChange = false;
+    if(!pWidget->m_Visible) return;
+
+    const sRect *pPainted = &Painted;
+    sRect Bounds = pWidget->m_Bounds;
+    Bounds.Intersect(Limit);
+    Damage.Intersect(Bounds);
+    if(!Damage.isEmpty() && !Painted.Contains(Damage)){
+        paintWidget(pWidget, Damage);
+        // Les blocs de la zone sont transmis même si les pixels n'ont pas changé
+        setRectChange(Damage);
+        pPainted = &Damage;
+    }
+
+    if(ChildChange){
+        for(cWidget *pChild = pWidget->m_pFirstChild; pChild != nullptr; pChild = pChild->m_pNext){
+            renderWidget(pChild, *pPainted, Bounds);
+        }
+    }
+}
+
+// --------------------------------------------------------------------------
+// Dessin d'un widget et de ses enfants, limité à Area
+void cGFX::paintWidget(cWidget *pWidget, const sRect &Area){
+    if(!pushClip(Area.m_x0, Area.m_y0, Area.m_x1 - Area.m_x0, Area.m_y1 - Area.m_y0)) return;
+    if(pWidget->m_pDraw != nullptr){
+        pWidget->m_pDraw(pWidget, this);
+    }
+    for(cWidget *pChild = pWidget->m_pFirstChild; pChild != nullptr; pChild = pChild->m_pNext){
+        if(!pChild->m_Visible) continue;
+        sRect ChildArea = Area;
+        ChildArea.Intersect(pChild->m_Bounds);
+        if(!ChildArea.isEmpty()){
+            paintWidget(pChild, ChildArea);
+        }
+    }
+    popClip();
+}
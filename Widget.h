@@ -0,0 +1,95 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2024 Dad Design.
+//      Widgets : arbre de zones d'affichage avec suivi des zones à redessiner
+//
+//      Chaque widget possède ses limites, une zone à redessiner et une fonction
+//      de dessin. cGFX::drawWidgets() ne redessine que les zones invalidées,
+//      limitées aux bornes des widgets. Aucune allocation dynamique : les widgets
+//      sont des objets statiques chaînés entre eux.
+//------------------------------------------------------------------------
+#pragma once
+#include "GFX.h"
+
+class cWidget;
+
+// Fonction de dessin d'un widget
+//   Appelée avec la zone de découpage limitée à la partie à redessiner du widget
+typedef void (*WidgetDrawCallback)(cWidget *pWidget, cGFX *pGFX);
+
+//***********************************************************************************
+// cWidget
+// Les coordonnées sont absolues (repère de la frame).
+// Les enfants sont dessinés après leur parent, dans l'ordre d'ajout, et sont
+// limités aux bornes de leur parent.
+// Un widget non opaque laisse voir son parent : lorsqu'il est invalidé, le parent
+// est redessiné dans la zone concernée, puis le widget par dessus.
+// La profondeur de l'arbre est limitée par CLIP_STACK_SIZE.
+//***********************************************************************************
+class cWidget {
+public:
+    friend class cGFX;
+
+    // --------------------------------------------------------------------------
+    // Initialisation, le widget est invalidé
+    void Init(int16_t x, int16_t y, uint16_t dx, uint16_t dy, WidgetDrawCallback pDraw,
+              void *pContext = nullptr, bool Opaque = true);
+
+    // --------------------------------------------------------------------------
+    // Ajout d'un enfant (dessiné au dessus des enfants précédents)
+    void addChild(cWidget *pChild);
+
+    // ==========================================================================
+    // Invalidation
+    // ==========================================================================
+    // Le widget entier doit être redessiné
+    inline void Invalidate(){
+        InvalidateRect(m_Bounds);
+    }
+
+    // Une partie du widget doit être redessinée
+    void InvalidateRect(const sRect &Area);
+
+    // ==========================================================================
+    // Position / visibilité
+    // ==========================================================================
+    // Changement des limites du widget (les enfants ne sont pas déplacés)
+    void setBounds(int16_t x, int16_t y, uint16_t dx, uint16_t dy);
+
+    // Déplacement relatif du widget et de ses enfants
+    void Move(int16_t dx, int16_t dy);
+
+    // Affichage / masquage
+    void setVisible(bool Visible);
+
+    // ==========================================================================
+    // Lecture
+    // ==========================================================================
+    inline const sRect &getBounds() { return m_Bounds; }
+    inline bool isVisible() { return m_Visible; }
+    inline bool isDirty() { return !m_Damage.isEmpty(); }
+    inline void *getContext() { return m_pContext; }
+    inline cWidget *getParent() { return m_pParent; }
+
+protected:
+    // Invalidation d'une zone d'un ancien emplacement (parent ou widget lui même)
+    void InvalidateArea(const sRect &Area);
+
+    // Signale aux ancêtres qu'un descendant doit être redessiné
+    void setAncestorsChanged();
+
+    // Déplacement des limites du widget et de sa descendance
+    void Translate(int16_t dx, int16_t dy);
+
+    sRect               m_Bounds = {0, 0, 0, 0};    // Limites du widget
+    sRect               m_Damage = {0, 0, 0, 0};    // Zone à redessiner
+    bool                m_ChildChange = false;      // Un descendant doit être redessiné
+    bool                m_Opaque = true;            // Le widget recouvre entièrement ses limites
+    bool                m_Visible = true;
+    WidgetDrawCallback  m_pDraw = nullptr;
+    void               *m_pContext = nullptr;
+
+    // Arbre
+    cWidget            *m_pParent = nullptr;
+    cWidget            *m_pFirstChild = nullptr;
+    cWidget            *m_pNext = nullptr;          // Frère suivant
+};